@@ -3,23 +3,55 @@
 //   - DECONV_CFG_IDX_0
 //   - DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P2
 //   - DECONV_CFG_IDX_1
-//   - DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1
+//   - DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P2_MM1
 //   - DECONV_CFG_IDX_2
-//   - DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2
+//   - DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1
 //   - DECONV_CFG_IDX_3
+//   - DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1_MM1
+//   - DECONV_CFG_IDX_4
+//   - DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2
+//   - DECONV_CFG_IDX_5
+//   - DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2_MM1
+//   - DECONV_CFG_IDX_6
 //   - DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P1
+//   - DECONV_CFG_IDX_7
+//   - DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P1_MM1
+//   - DECONV_CFG_IDX_8
+//   - DECONV_CFG_K4_S2_H8_W8_CI1_CO2_P0_OP1
+//   - DECONV_CFG_IDX_9
+//   - DECONV_CFG_K4_S2_H8_W8_CI1_CO2_P0_OP1_MM2
+//   - DECONV_CFG_IDX_10
+//   - DECONV_CFG_K3_S2_H4_W4_CI2_CO3_P1_NN2
+//   - DECONV_CFG_IDX_11
+//   - DECONV_CFG_K3_S2_H4_W4_CI2_CO3_P1_BL2
 
 #ifndef DECONV_TOP_SELECTOR_HPP
 #define DECONV_TOP_SELECTOR_HPP
 
 #if defined(DECONV_CFG_IDX_0) || defined(DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P2)
 #include "deconv_top_K3_S1_H3_W3_CI1_CO3_P2.hpp"
-#elif defined(DECONV_CFG_IDX_1) || defined(DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1)
+#elif defined(DECONV_CFG_IDX_1) || defined(DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P2_MM1)
+#include "deconv_top_K3_S1_H3_W3_CI1_CO3_P2_MM1.hpp"
+#elif defined(DECONV_CFG_IDX_2) || defined(DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1)
 #include "deconv_top_K3_S1_H3_W3_CI1_CO3_P1.hpp"
-#elif defined(DECONV_CFG_IDX_2) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2)
+#elif defined(DECONV_CFG_IDX_3) || defined(DECONV_CFG_K3_S1_H3_W3_CI1_CO3_P1_MM1)
+#include "deconv_top_K3_S1_H3_W3_CI1_CO3_P1_MM1.hpp"
+#elif defined(DECONV_CFG_IDX_4) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2)
 #include "deconv_top_K3_S1_H5_W5_CI1_CO3_P2.hpp"
-#elif defined(DECONV_CFG_IDX_3) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P1)
+#elif defined(DECONV_CFG_IDX_5) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P2_MM1)
+#include "deconv_top_K3_S1_H5_W5_CI1_CO3_P2_MM1.hpp"
+#elif defined(DECONV_CFG_IDX_6) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P1)
 #include "deconv_top_K3_S1_H5_W5_CI1_CO3_P1.hpp"
+#elif defined(DECONV_CFG_IDX_7) || defined(DECONV_CFG_K3_S1_H5_W5_CI1_CO3_P1_MM1)
+#include "deconv_top_K3_S1_H5_W5_CI1_CO3_P1_MM1.hpp"
+#elif defined(DECONV_CFG_IDX_8) || defined(DECONV_CFG_K4_S2_H8_W8_CI1_CO2_P0_OP1)
+#include "deconv_top_K4_S2_H8_W8_CI1_CO2_P0_OP1.hpp"
+#elif defined(DECONV_CFG_IDX_9) || defined(DECONV_CFG_K4_S2_H8_W8_CI1_CO2_P0_OP1_MM2)
+#include "deconv_top_K4_S2_H8_W8_CI1_CO2_P0_OP1_MM2.hpp"
+#elif defined(DECONV_CFG_IDX_10) || defined(DECONV_CFG_K3_S2_H4_W4_CI2_CO3_P1_NN2)
+#include "deconv_top_K3_S2_H4_W4_CI2_CO3_P1_NN2.hpp"
+#elif defined(DECONV_CFG_IDX_11) || defined(DECONV_CFG_K3_S2_H4_W4_CI2_CO3_P1_BL2)
+#include "deconv_top_K3_S2_H4_W4_CI2_CO3_P1_BL2.hpp"
 #else
 #include "deconv_top_K3_S1_H3_W3_CI1_CO3_P2.hpp"
 #endif
@@ -7,7 +7,14 @@
 
 constexpr unsigned  K = 3;		// kernel Size
 constexpr unsigned  S = 1; 		// stride
+constexpr unsigned  D = 1;		// dilation
 constexpr unsigned  P = 1;		// padding
+constexpr unsigned  PT = 1;		// padding top
+constexpr unsigned  PB = 1;		// padding bottom
+constexpr unsigned  PL = 1;		// padding left
+constexpr unsigned  PR = 1;		// padding right
+constexpr unsigned  OPH = 0;		// output padding (bottom)
+constexpr unsigned  OPW = 0;		// output padding (right)
 constexpr unsigned  H = 5;		// IFM height
 constexpr unsigned  W = 5;		// IFM Width
 constexpr unsigned  CI = 1;		// input channels
@@ -62,15 +69,15 @@ constexpr unsigned  SIMD = 1;
 
 
 static TW const  KERNEL[9][3][1] = {
-	{{0xbb,},{0x8f,},{0x18,}},
-	{{0xfb,},{0x89,},{0xc2,}},
-	{{0xc7,},{0x35,},{0x45,}},
-	{{0xa4,},{0x65,},{0xf8,}},
-	{{0x15,},{0x28,},{0x4d,}},
-	{{0xdb,},{0xb1,},{0x71,}},
-	{{0x2f,},{0xcd,},{0xa8,}},
-	{{0xce,},{0x2d,},{0x57,}},
-	{{0x90,},{0x9c,},{0xea,}},
+	{{0xbb,},{0xa4,},{0x2f,}},
+	{{0x8f,},{0x65,},{0xcd,}},
+	{{0x18,},{0xf8,},{0xa8,}},
+	{{0xfb,},{0x15,},{0xce,}},
+	{{0x89,},{0x28,},{0x2d,}},
+	{{0xc2,},{0x4d,},{0x57,}},
+	{{0xc7,},{0xdb,},{0x90,}},
+	{{0x35,},{0xb1,},{0x9c,}},
+	{{0x45,},{0x71,},{0xea,}},
 };
 
 #endif
@@ -0,0 +1,91 @@
+#ifndef DECONV_TOP_HPP
+#define DECONV_TOP_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#define DECONV_MM2IM				// per-pixel matrix multiplication, then col2im overlap-add
+
+constexpr unsigned  K = 3;		// kernel Size
+constexpr unsigned  S = 1; 		// stride
+constexpr unsigned  D = 1;		// dilation
+constexpr unsigned  P = 2;		// padding
+constexpr unsigned  PT = 2;		// padding top
+constexpr unsigned  PB = 2;		// padding bottom
+constexpr unsigned  PL = 2;		// padding left
+constexpr unsigned  PR = 2;		// padding right
+constexpr unsigned  OPH = 0;		// output padding (bottom)
+constexpr unsigned  OPW = 0;		// output padding (right)
+constexpr unsigned  H = 5;		// IFM height
+constexpr unsigned  W = 5;		// IFM Width
+constexpr unsigned  CI = 1;		// input channels
+constexpr unsigned  CO = 3;		// output channels
+
+using  TW = ap_uint< 8>;
+using  TI = ap_uint< 4>;
+using  TO = ap_uint<16>;
+
+#if 1
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[27][1][1] = {
+	{{0x39,}},
+	{{0xf0,}},
+	{{0xfc,}},
+	{{0xd2,}},
+	{{0x60,}},
+	{{0x0d,}},
+	{{0x0a,}},
+	{{0x17,}},
+	{{0x7c,}},
+	{{0x51,}},
+	{{0x87,}},
+	{{0x79,}},
+	{{0x98,}},
+	{{0xca,}},
+	{{0xdc,}},
+	{{0x94,}},
+	{{0xa0,}},
+	{{0x8c,}},
+	{{0xc1,}},
+	{{0x5e,}},
+	{{0x3c,}},
+	{{0xe9,}},
+	{{0x98,}},
+	{{0x52,}},
+	{{0x73,}},
+	{{0x61,}},
+	{{0x82,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 3;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[9][3][1] = {
+	{{0x39,},{0x51,},{0xc1,}},
+	{{0xf0,},{0x87,},{0x5e,}},
+	{{0xfc,},{0x79,},{0x3c,}},
+	{{0xd2,},{0x98,},{0xe9,}},
+	{{0x60,},{0xca,},{0x98,}},
+	{{0x0d,},{0xdc,},{0x52,}},
+	{{0x0a,},{0x94,},{0x73,}},
+	{{0x17,},{0xa0,},{0x61,}},
+	{{0x7c,},{0x8c,},{0x82,}},
+};
+
+#endif
+void deconv_top(
+    hls::stream<hls::vector<TI, SIMD>> &src,
+    hls::stream<hls::vector<TO, PE>>   &dst
+);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef DECONV_TOP_HPP
+#define DECONV_TOP_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#define DECONV_RESIZE_CONV			// resize by S, then stride-1 convolution
+constexpr unsigned  RESIZE = 2;		// bilinear
+
+constexpr unsigned  K = 3;		// kernel Size
+constexpr unsigned  S = 2; 		// stride
+constexpr unsigned  D = 1;		// dilation
+constexpr unsigned  P = 1;		// padding
+constexpr unsigned  PT = 1;		// padding top
+constexpr unsigned  PB = 1;		// padding bottom
+constexpr unsigned  PL = 1;		// padding left
+constexpr unsigned  PR = 1;		// padding right
+constexpr unsigned  OPH = 0;		// output padding (bottom)
+constexpr unsigned  OPW = 0;		// output padding (right)
+constexpr unsigned  H = 4;		// IFM height
+constexpr unsigned  W = 4;		// IFM Width
+constexpr unsigned  CI = 2;		// input channels
+constexpr unsigned  CO = 3;		// output channels
+
+using  TW = ap_uint< 8>;
+using  TI = ap_uint< 4>;
+using  TO = ap_uint<20>;
+
+#if 1
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[54][1][1] = {
+	{{0x66,}},
+	{{0x72,}},
+	{{0x36,}},
+	{{0xee,}},
+	{{0xa4,}},
+	{{0xdc,}},
+	{{0x62,}},
+	{{0x3d,}},
+	{{0x71,}},
+	{{0x02,}},
+	{{0xec,}},
+	{{0x25,}},
+	{{0xb1,}},
+	{{0xdc,}},
+	{{0x71,}},
+	{{0xf0,}},
+	{{0xc0,}},
+	{{0xe7,}},
+	{{0xf6,}},
+	{{0xc3,}},
+	{{0x73,}},
+	{{0x49,}},
+	{{0x70,}},
+	{{0x75,}},
+	{{0x41,}},
+	{{0x14,}},
+	{{0xd5,}},
+	{{0xea,}},
+	{{0x38,}},
+	{{0xab,}},
+	{{0xb3,}},
+	{{0x51,}},
+	{{0x53,}},
+	{{0x1d,}},
+	{{0x05,}},
+	{{0x86,}},
+	{{0x35,}},
+	{{0xb9,}},
+	{{0xd4,}},
+	{{0x5a,}},
+	{{0x50,}},
+	{{0x8d,}},
+	{{0x58,}},
+	{{0x4b,}},
+	{{0xb9,}},
+	{{0xf3,}},
+	{{0xdb,}},
+	{{0xe6,}},
+	{{0x55,}},
+	{{0x34,}},
+	{{0x7e,}},
+	{{0x50,}},
+	{{0x7e,}},
+	{{0x1d,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 2;
+
+
+static TW const  KERNEL[27][1][2] = {
+	{{0x66,0x72,}},
+	{{0x36,0xee,}},
+	{{0xa4,0xdc,}},
+	{{0x62,0x3d,}},
+	{{0x71,0x02,}},
+	{{0xec,0x25,}},
+	{{0xb1,0xdc,}},
+	{{0x71,0xf0,}},
+	{{0xc0,0xe7,}},
+	{{0xf6,0xc3,}},
+	{{0x73,0x49,}},
+	{{0x70,0x75,}},
+	{{0x41,0x14,}},
+	{{0xd5,0xea,}},
+	{{0x38,0xab,}},
+	{{0xb3,0x51,}},
+	{{0x53,0x1d,}},
+	{{0x05,0x86,}},
+	{{0x35,0xb9,}},
+	{{0xd4,0x5a,}},
+	{{0x50,0x8d,}},
+	{{0x58,0x4b,}},
+	{{0xb9,0xf3,}},
+	{{0xdb,0xe6,}},
+	{{0x55,0x34,}},
+	{{0x7e,0x50,}},
+	{{0x7e,0x1d,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 3;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[18][3][1] = {
+	{{0x66,},{0xf6,},{0x35,}},
+	{{0x72,},{0xc3,},{0xb9,}},
+	{{0x36,},{0x73,},{0xd4,}},
+	{{0xee,},{0x49,},{0x5a,}},
+	{{0xa4,},{0x70,},{0x50,}},
+	{{0xdc,},{0x75,},{0x8d,}},
+	{{0x62,},{0x41,},{0x58,}},
+	{{0x3d,},{0x14,},{0x4b,}},
+	{{0x71,},{0xd5,},{0xb9,}},
+	{{0x02,},{0xea,},{0xf3,}},
+	{{0xec,},{0x38,},{0xdb,}},
+	{{0x25,},{0xab,},{0xe6,}},
+	{{0xb1,},{0xb3,},{0x55,}},
+	{{0xdc,},{0x51,},{0x34,}},
+	{{0x71,},{0x53,},{0x7e,}},
+	{{0xf0,},{0x1d,},{0x50,}},
+	{{0xc0,},{0x05,},{0x7e,}},
+	{{0xe7,},{0x86,},{0x1d,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 3;
+
+constexpr unsigned  SIMD = 2;
+
+
+static TW const  KERNEL[9][3][2] = {
+	{{0x66,0x72,},{0xf6,0xc3,},{0x35,0xb9,}},
+	{{0x36,0xee,},{0x73,0x49,},{0xd4,0x5a,}},
+	{{0xa4,0xdc,},{0x70,0x75,},{0x50,0x8d,}},
+	{{0x62,0x3d,},{0x41,0x14,},{0x58,0x4b,}},
+	{{0x71,0x02,},{0xd5,0xea,},{0xb9,0xf3,}},
+	{{0xec,0x25,},{0x38,0xab,},{0xdb,0xe6,}},
+	{{0xb1,0xdc,},{0xb3,0x51,},{0x55,0x34,}},
+	{{0x71,0xf0,},{0x53,0x1d,},{0x7e,0x50,}},
+	{{0xc0,0xe7,},{0x05,0x86,},{0x7e,0x1d,}},
+};
+
+#endif
+void deconv_top(
+    hls::stream<hls::vector<TI, SIMD>> &src,
+    hls::stream<hls::vector<TO, PE>>   &dst
+);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef DECONV_TOP_HPP
+#define DECONV_TOP_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#define DECONV_RESIZE_CONV			// resize by S, then stride-1 convolution
+constexpr unsigned  RESIZE = 1;		// nearest
+
+constexpr unsigned  K = 3;		// kernel Size
+constexpr unsigned  S = 2; 		// stride
+constexpr unsigned  D = 1;		// dilation
+constexpr unsigned  P = 1;		// padding
+constexpr unsigned  PT = 1;		// padding top
+constexpr unsigned  PB = 1;		// padding bottom
+constexpr unsigned  PL = 1;		// padding left
+constexpr unsigned  PR = 1;		// padding right
+constexpr unsigned  OPH = 0;		// output padding (bottom)
+constexpr unsigned  OPW = 0;		// output padding (right)
+constexpr unsigned  H = 4;		// IFM height
+constexpr unsigned  W = 4;		// IFM Width
+constexpr unsigned  CI = 2;		// input channels
+constexpr unsigned  CO = 3;		// output channels
+
+using  TW = ap_uint< 8>;
+using  TI = ap_uint< 4>;
+using  TO = ap_uint<16>;
+
+#if 1
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[54][1][1] = {
+	{{0x91,}},
+	{{0x4c,}},
+	{{0x13,}},
+	{{0x85,}},
+	{{0xfa,}},
+	{{0xef,}},
+	{{0x02,}},
+	{{0xcc,}},
+	{{0xa3,}},
+	{{0xa9,}},
+	{{0x64,}},
+	{{0x70,}},
+	{{0xeb,}},
+	{{0x40,}},
+	{{0xff,}},
+	{{0xf2,}},
+	{{0xbb,}},
+	{{0x16,}},
+	{{0x16,}},
+	{{0xd8,}},
+	{{0x4c,}},
+	{{0x45,}},
+	{{0x17,}},
+	{{0x95,}},
+	{{0xff,}},
+	{{0x39,}},
+	{{0x95,}},
+	{{0x8b,}},
+	{{0x37,}},
+	{{0x3d,}},
+	{{0x06,}},
+	{{0x34,}},
+	{{0x7b,}},
+	{{0x25,}},
+	{{0x67,}},
+	{{0xee,}},
+	{{0x0f,}},
+	{{0xa3,}},
+	{{0x4a,}},
+	{{0xbc,}},
+	{{0xf6,}},
+	{{0x9d,}},
+	{{0x0c,}},
+	{{0x4d,}},
+	{{0x45,}},
+	{{0xfa,}},
+	{{0x61,}},
+	{{0xd8,}},
+	{{0x50,}},
+	{{0x58,}},
+	{{0x87,}},
+	{{0x08,}},
+	{{0x5e,}},
+	{{0x27,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 2;
+
+
+static TW const  KERNEL[27][1][2] = {
+	{{0x91,0x4c,}},
+	{{0x13,0x85,}},
+	{{0xfa,0xef,}},
+	{{0x02,0xcc,}},
+	{{0xa3,0xa9,}},
+	{{0x64,0x70,}},
+	{{0xeb,0x40,}},
+	{{0xff,0xf2,}},
+	{{0xbb,0x16,}},
+	{{0x16,0xd8,}},
+	{{0x4c,0x45,}},
+	{{0x17,0x95,}},
+	{{0xff,0x39,}},
+	{{0x95,0x8b,}},
+	{{0x37,0x3d,}},
+	{{0x06,0x34,}},
+	{{0x7b,0x25,}},
+	{{0x67,0xee,}},
+	{{0x0f,0xa3,}},
+	{{0x4a,0xbc,}},
+	{{0xf6,0x9d,}},
+	{{0x0c,0x4d,}},
+	{{0x45,0xfa,}},
+	{{0x61,0xd8,}},
+	{{0x50,0x58,}},
+	{{0x87,0x08,}},
+	{{0x5e,0x27,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 3;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[18][3][1] = {
+	{{0x91,},{0x16,},{0x0f,}},
+	{{0x4c,},{0xd8,},{0xa3,}},
+	{{0x13,},{0x4c,},{0x4a,}},
+	{{0x85,},{0x45,},{0xbc,}},
+	{{0xfa,},{0x17,},{0xf6,}},
+	{{0xef,},{0x95,},{0x9d,}},
+	{{0x02,},{0xff,},{0x0c,}},
+	{{0xcc,},{0x39,},{0x4d,}},
+	{{0xa3,},{0x95,},{0x45,}},
+	{{0xa9,},{0x8b,},{0xfa,}},
+	{{0x64,},{0x37,},{0x61,}},
+	{{0x70,},{0x3d,},{0xd8,}},
+	{{0xeb,},{0x06,},{0x50,}},
+	{{0x40,},{0x34,},{0x58,}},
+	{{0xff,},{0x7b,},{0x87,}},
+	{{0xf2,},{0x25,},{0x08,}},
+	{{0xbb,},{0x67,},{0x5e,}},
+	{{0x16,},{0xee,},{0x27,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 3;
+
+constexpr unsigned  SIMD = 2;
+
+
+static TW const  KERNEL[9][3][2] = {
+	{{0x91,0x4c,},{0x16,0xd8,},{0x0f,0xa3,}},
+	{{0x13,0x85,},{0x4c,0x45,},{0x4a,0xbc,}},
+	{{0xfa,0xef,},{0x17,0x95,},{0xf6,0x9d,}},
+	{{0x02,0xcc,},{0xff,0x39,},{0x0c,0x4d,}},
+	{{0xa3,0xa9,},{0x95,0x8b,},{0x45,0xfa,}},
+	{{0x64,0x70,},{0x37,0x3d,},{0x61,0xd8,}},
+	{{0xeb,0x40,},{0x06,0x34,},{0x50,0x58,}},
+	{{0xff,0xf2,},{0x7b,0x25,},{0x87,0x08,}},
+	{{0xbb,0x16,},{0x67,0xee,},{0x5e,0x27,}},
+};
+
+#endif
+void deconv_top(
+    hls::stream<hls::vector<TI, SIMD>> &src,
+    hls::stream<hls::vector<TO, PE>>   &dst
+);
+
+#endif
\ No newline at end of file
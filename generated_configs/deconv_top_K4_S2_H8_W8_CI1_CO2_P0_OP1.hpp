@@ -0,0 +1,101 @@
+#ifndef DECONV_TOP_HPP
+#define DECONV_TOP_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+constexpr unsigned  K = 4;		// kernel Size
+constexpr unsigned  S = 2; 		// stride
+constexpr unsigned  D = 1;		// dilation
+constexpr unsigned  P = 0;		// padding
+constexpr unsigned  PT = 0;		// padding top
+constexpr unsigned  PB = 0;		// padding bottom
+constexpr unsigned  PL = 0;		// padding left
+constexpr unsigned  PR = 0;		// padding right
+constexpr unsigned  OPH = 1;		// output padding (bottom)
+constexpr unsigned  OPW = 1;		// output padding (right)
+constexpr unsigned  H = 8;		// IFM height
+constexpr unsigned  W = 8;		// IFM Width
+constexpr unsigned  CI = 1;		// input channels
+constexpr unsigned  CO = 2;		// output channels
+
+using  TW = ap_uint< 8>;
+using  TI = ap_uint< 4>;
+using  TO = ap_uint<16>;
+
+#if 1
+
+constexpr unsigned  PE   = 1;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[32][1][1] = {
+	{{0xb6,}},
+	{{0x16,}},
+	{{0xb4,}},
+	{{0xd6,}},
+	{{0x1e,}},
+	{{0xf2,}},
+	{{0x90,}},
+	{{0x21,}},
+	{{0xfe,}},
+	{{0x64,}},
+	{{0xcb,}},
+	{{0x11,}},
+	{{0xb8,}},
+	{{0x02,}},
+	{{0x03,}},
+	{{0xc4,}},
+	{{0x9b,}},
+	{{0xab,}},
+	{{0x17,}},
+	{{0xf8,}},
+	{{0x62,}},
+	{{0x57,}},
+	{{0xce,}},
+	{{0x5b,}},
+	{{0x60,}},
+	{{0x89,}},
+	{{0x40,}},
+	{{0x6d,}},
+	{{0x64,}},
+	{{0xd2,}},
+	{{0x34,}},
+	{{0x51,}},
+};
+
+#else
+
+constexpr unsigned  PE   = 2;
+
+constexpr unsigned  SIMD = 1;
+
+
+static TW const  KERNEL[16][2][1] = {
+	{{0xb6,},{0x9b,}},
+	{{0x16,},{0xab,}},
+	{{0xb4,},{0x17,}},
+	{{0xd6,},{0xf8,}},
+	{{0x1e,},{0x62,}},
+	{{0xf2,},{0x57,}},
+	{{0x90,},{0xce,}},
+	{{0x21,},{0x5b,}},
+	{{0xfe,},{0x60,}},
+	{{0x64,},{0x89,}},
+	{{0xcb,},{0x40,}},
+	{{0x11,},{0x6d,}},
+	{{0xb8,},{0x64,}},
+	{{0x02,},{0xd2,}},
+	{{0x03,},{0x34,}},
+	{{0xc4,},{0x51,}},
+};
+
+#endif
+void deconv_top(
+    hls::stream<hls::vector<TI, SIMD>> &src,
+    hls::stream<hls::vector<TO, PE>>   &dst
+);
+
+#endif
\ No newline at end of file
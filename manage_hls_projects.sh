@@ -15,6 +15,7 @@ PROJECTS_DIR="${SCRIPT_DIR}/hls_projects"
 DATA_ROOT="${SCRIPT_DIR}/deconv_data"
 EXP_DATA_DIR="${DATA_ROOT}/exp_data"
 CONFIG_CSV="${DATA_ROOT}/configs/deconv_configs.csv"
+PYTHON_BIN="${PYTHON:-python3}"  # override via env PYTHON=<executable>
 
 # Colors for output
 RED='\033[0;31m'
@@ -53,6 +54,11 @@ Commands:
     csim           - Run C simulation on all projects (requires Vitis 2024.1+ or Vivado HLS)
     synthesize     - Run synthesis on all projects (requires Vitis 2024.1+ or Vivado HLS)
     cosim          - Run co-simulation on all projects (requires Vitis 2024.1+ or Vivado HLS)
+    verilate       - Simulate exported RTL of all synthesized solutions with Verilator (no Vitis needed)
+    host-bench     - Benchmark the C model of every generated config with perf_event counters (JSON)
+    host-sched     - Schedule prioritized multi-stream frames onto the C model, per-stream tail latency (JSON)
+    gather-timing  - Collect clock sweep timing and achievable throughput per configuration
+    gather-cosim   - Collect co-simulation latency/interval and compare against csynth + cycle model
     gather-outputs - Gather C simulation output CSV files with PE/SIMD naming into outputs folder
     gather-golden  - Copy golden reference output files from experimental data
     compare-results - Compare simulation outputs with golden reference results
@@ -70,6 +76,11 @@ Examples:
     $0 csim                        # Run C simulation on all projects
     $0 synthesize                  # Run synthesis on all projects
     $0 cosim                       # Run co-simulation on all projects
+    $0 verilate                    # Cycle-accurate RTL check + cycles/frame via Verilator
+    $0 host-bench                  # Host cycles/instructions/cache/branch misses per output pixel
+    $0 host-sched                  # Queueing delay / tail latency per stream under a priority scheduler
+    $0 gather-timing               # Summarize Fmax / throughput of synthesized solutions
+    $0 gather-cosim                # Summarize measured cosim latency vs. prediction
     $0 gather-outputs              # Gather C simulation CSV files with PE/SIMD naming
     $0 gather-golden               # Copy golden reference output files
     $0 compare-results             # Compare simulation outputs with golden results
@@ -77,8 +88,27 @@ Examples:
     $0 clean                       # Remove all generated projects
     $0 list                        # Show available configurations
 
+Clock Sweep:
+    DECONV_CLOCK_PERIODS="5 4 3.3" $0 generate   # One solution per PE/SIMD and clock period (ns)
+    DECONV_RUN_IMPL=1 $0 synthesize              # Also run implementation for post-route timing
+
+Back-to-Back Frames:
+    DECONV_TB_FRAMES=4 $0 generate               # csim/cosim stream 4 frames, report inter-frame interval
+
+Verilator Options (environment):
+    VERILATOR_FRAMES=8 VERILATOR_READY=70 VERILATOR_VALID=90 $0 verilate
+
+Host Benchmark Options (environment):
+    BENCH_RUNS=10 BENCH_FRAMES=4 BENCH_STAGES=1 $0 host-bench
+
+Host Scheduler Options (environment):
+    SCHED_STREAMS="cam0:2:500:800 cam1:1:1000:2000 bulk:0:1.2f:0:4" SCHED_POLICY=edf $0 host-sched
+
 Requirements:
     - For 'generate', 'csim', 'synthesize', 'cosim': Vitis 2024.1+ (preferred) or Vivado HLS (legacy)
+    - For 'verilate': Verilator 5.x and previously exported RTL (syn/verilog)
+    - For 'host-bench': g++, HLS headers (\$XILINX_HLS/include or HLS_INCLUDE) and perf_event access
+    - For 'host-sched': g++ and HLS headers (\$XILINX_HLS/include or HLS_INCLUDE)
     - For other commands: Only tclsh is required
 
 Data Locations (defaults):
@@ -268,6 +298,94 @@ synthesize_all() {
         log_error "Synthesis failed!"
         return 1
     fi
+
+    gather_timing || true
+}
+
+verilate_all() {
+    log_header "Running Verilator RTL Simulation"
+
+    if [ ! -d "$PROJECTS_DIR" ]; then
+        log_error "Projects directory not found: $PROJECTS_DIR"
+        return 1
+    fi
+
+    local passed=0
+    local failed=0
+    for rtl_dir in "$PROJECTS_DIR"/deconv_*/solution*/syn/verilog; do
+        if [ ! -f "$rtl_dir/deconv_top.v" ]; then
+            continue
+        fi
+        local solution_dir="$(dirname "$(dirname "$rtl_dir")")"
+        log_info "Simulating: $(basename "$(dirname "$solution_dir")")/$(basename "$solution_dir")"
+        if "${SCRIPT_DIR}/scripts/verilator_sim.sh" "$solution_dir" \
+                --frames "${VERILATOR_FRAMES:-4}" \
+                --ready "${VERILATOR_READY:-100}" \
+                --valid "${VERILATOR_VALID:-100}"; then
+            passed=$((passed + 1))
+        else
+            log_error "Verilator simulation failed for $solution_dir"
+            failed=$((failed + 1))
+        fi
+    done
+
+    if [ $((passed + failed)) -eq 0 ]; then
+        log_warn "No exported RTL found. Run '$0 synthesize' first."
+        return 1
+    fi
+    log_info "Verilator simulations passed: $passed, failed: $failed"
+    [ $failed -eq 0 ]
+}
+
+host_bench() {
+    log_header "Benchmarking C Model with Hardware Counters"
+
+    if [ ! -d "$CONFIG_DIR" ]; then
+        log_error "Generated configs not found: $CONFIG_DIR"
+        return 1
+    fi
+
+    local args=(--runs "${BENCH_RUNS:-5}" --frames "${BENCH_FRAMES:-1}" --out-dir "${SCRIPT_DIR}/bench_results")
+    if [ "${BENCH_STAGES:-0}" != "0" ]; then
+        args+=(--stages)
+    fi
+    "${SCRIPT_DIR}/scripts/host_bench.sh" "${args[@]}"
+}
+
+host_sched() {
+    log_header "Scheduling Multi-Stream Frames on the C Model"
+
+    if [ ! -d "$CONFIG_DIR" ]; then
+        log_error "Generated configs not found: $CONFIG_DIR"
+        return 1
+    fi
+
+    local args=(--policy "${SCHED_POLICY:-priority}" --out-dir "${SCRIPT_DIR}/sched_results")
+    local spec
+    for spec in ${SCHED_STREAMS:-}; do
+        args+=(--stream "$spec")
+    done
+    if [ -n "${SCHED_AGING_US:-}" ]; then
+        args+=(--aging-us "$SCHED_AGING_US")
+    fi
+    "${SCRIPT_DIR}/scripts/host_sched.sh" "${args[@]}"
+}
+
+gather_timing() {
+    log_header "Gathering Clock Sweep Timing"
+
+    if [ ! -d "$PROJECTS_DIR" ]; then
+        log_error "Projects directory not found: $PROJECTS_DIR"
+        return 1
+    fi
+
+    cd "$SCRIPT_DIR"
+    if ! "$PYTHON_BIN" scripts/collect_timing.py --projects-dir "$PROJECTS_DIR"; then
+        log_warn "No timing collected. Run '$0 synthesize' first."
+        return 1
+    fi
+    log_info "Timing summary: ${PROJECTS_DIR}/timing_summary.csv"
+    log_info "Best achievable throughput per configuration: ${PROJECTS_DIR}/timing_best.csv"
 }
 
 cosim_all() {
@@ -304,6 +422,32 @@ cosim_all() {
         log_error "Co-simulation failed!"
         return 1
     fi
+
+    gather_cosim || true
+}
+
+gather_cosim() {
+    log_header "Gathering Co-simulation Performance"
+
+    if [ ! -d "$PROJECTS_DIR" ]; then
+        log_error "Projects directory not found: $PROJECTS_DIR"
+        return 1
+    fi
+
+    cd "$SCRIPT_DIR"
+    if ! "$PYTHON_BIN" scripts/collect_cosim.py --projects-dir "$PROJECTS_DIR" \
+            --tolerance "${DECONV_COSIM_TOLERANCE:-0.2}"; then
+        log_warn "No co-simulation results collected. Run '$0 cosim' first."
+        return 1
+    fi
+    log_info "Co-simulation summary: ${PROJECTS_DIR}/cosim_summary.csv"
+
+    # Collate with the most recent comparison run
+    local latest_run="${SCRIPT_DIR}/comparison_results/latest"
+    if [ -d "$latest_run" ]; then
+        cp "${PROJECTS_DIR}/cosim_summary.csv" "$latest_run/"
+        log_info "Copied co-simulation summary into: $latest_run"
+    fi
 }
 
 clean_projects() {
@@ -375,7 +519,7 @@ list_configurations() {
         local filename=$(basename "$config_file")
         
         # Extract parameters using regex
-        if [[ $filename =~ deconv_top_K([0-9]+)_S([0-9]+)_H([0-9]+)_W([0-9]+)_CI([0-9]+)_CO([0-9]+)_P([0-9]+)\.hpp ]]; then
+        if [[ $filename =~ deconv_top_K([0-9]+)_S([0-9]+)_H([0-9]+)_W([0-9]+)_CI([0-9]+)_CO([0-9]+)_P([0-9]+)((_[A-Z]+[0-9]+)*)\.hpp ]]; then
             local K=${BASH_REMATCH[1]}
             local S=${BASH_REMATCH[2]}
             local H=${BASH_REMATCH[3]}
@@ -383,10 +527,11 @@ list_configurations() {
             local CI=${BASH_REMATCH[5]}
             local CO=${BASH_REMATCH[6]}
             local P=${BASH_REMATCH[7]}
+            local edges=${BASH_REMATCH[8]}
             
             echo "  $filename"
-            echo "    Parameters: K=$K, S=$S, H=$H, W=$W, CI=$CI, CO=$CO, P=$P"
-            echo "    Project name: deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}"
+            echo "    Parameters: K=$K, S=$S, H=$H, W=$W, CI=$CI, CO=$CO, P=$P${edges:+ (edges/output padding: ${edges#_})}"
+            echo "    Project name: deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}${edges}"
             echo
         else
             echo "  $filename (could not parse parameters)"
@@ -562,10 +707,13 @@ compare_results() {
         # Example: deconv_3x3_in1_out3_k3_s1_p2_output_hls_PE1_SIMD1.csv
         # Should match: deconv_3x3_in1_out3_k3_s1_p2_output.csv
         local config_pattern=""
-        if [[ "$output_basename" =~ deconv_([0-9]+x[0-9]+_in[0-9]+_out[0-9]+_k[0-9]+_s[0-9]+_p[0-9]+)_output_hls_(PE[0-9]+_SIMD[0-9]+)\.csv ]]; then
+        # Asymmetric layers carry further edge tags: ..._p0_pb1_pl0_pr1_op1_output_hls_...
+        if [[ "$output_basename" =~ deconv_([0-9]+x[0-9]+_in[0-9]+_out[0-9]+_k[0-9]+_s[0-9]+_p[0-9]+(_[a-z]+[0-9]+)*)_output_hls_(PE[0-9]+_SIMD[0-9]+)\.csv ]]; then
             local config_base="${BASH_REMATCH[1]}"
-            local pe_simd="${BASH_REMATCH[2]}"
-            config_pattern="deconv_${config_base}_output.csv"
+            local pe_simd="${BASH_REMATCH[3]}"
+            # The conv + depth-to-space rewrite (_ps<S>) and MM2IM (_mm<S>) share the
+            # golden data of their layer
+            config_pattern="deconv_$(echo "$config_base" | sed -E 's/_(ps|mm)[0-9]+$//')_output.csv"
         else
             log_warn "Could not parse configuration from: $output_basename"
             continue
@@ -716,6 +864,21 @@ main() {
             synthesize_all
             cosim_all
             ;;
+        verilate)
+            verilate_all
+            ;;
+        host-bench)
+            host_bench
+            ;;
+        host-sched)
+            host_sched
+            ;;
+        gather-timing)
+            gather_timing
+            ;;
+        gather-cosim)
+            gather_cosim
+            ;;
         gather-outputs)
             gather_outputs
             ;;
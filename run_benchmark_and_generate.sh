@@ -19,7 +19,12 @@
 #   ./run_benchmark_and_generate.sh --param-file parameter_space.json --limit 1 --dry-run
 #
 # Common options passed through to benchmark:
-#   --seed, --device, --bias, --limit, --dry-run, --no-clean
+#   --seed, --device, --bias, --precision, --limit, --dry-run, --clean, --force,
+#   --prune
+#
+# Data generation is incremental: only configurations that are new or whose
+# key (config, seed, ranges, precision, bias) changed are regenerated, see
+# <out-dir>/manifest.json. Pass --clean to start from an empty out-dir.
 #
 # After successful benchmark generation this script locates:
 #   <out-dir>/configs/deconv_configs.csv
@@ -39,13 +44,18 @@ config_dir="generated_configs"
 seed="1"
 device="cpu"
 bias="false"
-clean="true"  # default behavior removes existing out_dir
+clean="false"  # default keeps out_dir and regenerates stale data sets only
+force="false"
+prune="false"
+precision="float32"
 limit=""
 dry_run="false"
 input_low="1"
 input_high="1"
 weight_low="0"
 weight_high="255"
+depth_to_space="false"
+mm2im="true"
 
 print_usage() {
   cat <<USAGE
@@ -62,13 +72,19 @@ Benchmark Options:
   --device <cpu|cuda>     Torch device (default: cpu)
   --bias                  Enable bias parameter in ConvTranspose2d (default: off)
   --limit <int>           Limit number of configurations (debug)
+  --precision <type>      Reference computation type: float32 | float64 (default: float32)
   --dry-run               List configurations only; skip tensor generation & header generation
-  --no-clean              Do not remove existing out-dir before generation
+  --clean                 Remove existing out-dir before generation
+  --no-clean              Keep out-dir, regenerate new/changed configurations only (default)
+  --force                 Regenerate all configurations even if their data are current
+  --prune                 Delete data of configurations no longer in the parameter space
   --input-range <L H>     Inclusive range for input tensor values (default: 1 1)
   --weight-range <L H>    Inclusive range for weight (and bias) values (default: 0 255)
 
 Config Generation Options:
   --config-dir <dir>      Directory to write generated header files (default: generated_configs)
+  --depth-to-space        Also generate the conv + depth-to-space rewrite (_PS<S>) of strided layers
+  --no-mm2im              Skip the MM2IM engine (_MM<S>) generated next to every transposed conv
 
 Environment:
   PYTHON=<exe>            Override Python executable (default: python3)
@@ -96,6 +112,10 @@ while [[ $# -gt 0 ]]; do
       out_dir="$2"; shift 2 ;;
     --config-dir)
       config_dir="$2"; shift 2 ;;
+    --depth-to-space)
+      depth_to_space="true"; shift 1 ;;
+    --no-mm2im)
+      mm2im="false"; shift 1 ;;
     --seed)
       seed="$2"; shift 2 ;;
     --device)
@@ -106,8 +126,16 @@ while [[ $# -gt 0 ]]; do
       limit="$2"; shift 2 ;;
     --dry-run)
       dry_run="true"; shift 1 ;;
+    --precision)
+      precision="$2"; shift 2 ;;
+    --clean)
+      clean="true"; shift 1 ;;
     --no-clean)
       clean="false"; shift 1 ;;
+    --force)
+      force="true"; shift 1 ;;
+    --prune)
+      prune="true"; shift 1 ;;
     --input-range)
       if [[ $# -lt 3 ]]; then echo "Error: --input-range requires two integers" >&2; exit 1; fi
       input_low="$2"; input_high="$3"; shift 3 ;;
@@ -151,7 +179,9 @@ echo "[INFO] Headers config-dir: $config_dir"
 echo "[INFO] Seed              : $seed"
 echo "[INFO] Device            : $device"
 echo "[INFO] Bias enabled      : $bias"
+echo "[INFO] Precision         : $precision"
 echo "[INFO] Clean out-dir     : $clean"
+echo "[INFO] Force regenerate  : $force"
 echo "[INFO] Dry-run           : $dry_run"
 echo "[INFO] Input range       : $input_low $input_high"
 echo "[INFO] Weight range      : $weight_low $weight_high"
@@ -171,10 +201,13 @@ benchmark_cmd=(
   --device "$device"
   --input-range "$input_low" "$input_high"
   --weight-range "$weight_low" "$weight_high"
+  --precision "$precision"
 )
 
 [[ "$bias" == "true" ]] && benchmark_cmd+=(--bias)
 [[ "$clean" == "false" ]] && benchmark_cmd+=(--no-clean) || benchmark_cmd+=(--clean)
+[[ "$force" == "true" ]] && benchmark_cmd+=(--force)
+[[ "$prune" == "true" ]] && benchmark_cmd+=(--prune)
 [[ -n "$limit" ]] && benchmark_cmd+=(--limit "$limit")
 [[ "$dry_run" == "true" ]] && benchmark_cmd+=(--dry-run)
 
@@ -210,6 +243,8 @@ gen_cmd=(
   --exp-data "$exp_data_dir"
   --output "$config_dir"
 )
+[[ "$depth_to_space" == "true" ]] && gen_cmd+=(--depth-to-space)
+[[ "$mm2im" == "true" ]] && gen_cmd+=(--mm2im)
 printf '       '; printf '%q ' "${gen_cmd[@]}"; echo
 "${gen_cmd[@]}"
 echo "------------------------------------------------------------"
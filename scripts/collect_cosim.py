@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+Co-Simulation Performance Collector
+===================================
+
+Gathers the measured RTL latency / interval of every co-simulated solution
+(`sim/report/deconv_top_cosim.rpt`) together with the transactions and input
+beats driven by the testbench (`sim/tv/cdatafile/*.dat`, from which the number
+of frames follows) and joins them with:
+
+  - the csynth estimates        (syn/report/csynth.xml)
+  - the analytical cycle model  (deconv_model.py)
+
+Solutions whose measured cycles per frame deviate from the model by more than
+--tolerance are flagged as OFF_MODEL.
+
+Outputs (in --projects-dir unless --out-dir is given):
+  - cosim_summary.csv : one row per co-simulated solution
+
+Usage:
+  python collect_cosim.py --projects-dir hls_projects --tolerance 0.2
+"""
+from __future__ import annotations
+
+import argparse
+import csv
+import glob
+import os
+import re
+import sys
+from typing import Dict, List, Optional
+
+from collect_timing import parse_csynth_xml
+from deconv_model import design_from_names
+
+# | Verilog | Pass | 706 | 706 | 706 | NA | NA | NA | 1412 |
+COSIM_ROW_RE = re.compile(
+    r"^\|\s*(Verilog|VHDL)\s*\|\s*(\w+)\s*\|" + r"\s*([0-9A-Za-z.]+)\s*\|" * 7, re.MULTILINE)
+TRANSACTION_RE = re.compile(r"^\[\[transaction\]\]", re.MULTILINE)
+
+FIELDS = [
+    "project", "solution", "PE", "SIMD", "rtl", "status",
+    "latency_min", "latency_avg", "latency_max",
+    "interval_min", "interval_avg", "interval_max",
+    "total_cycles", "transactions", "frames",
+    "csynth_latency", "csynth_interval", "model_cycles_per_frame",
+    "measured_cycles_per_frame", "measured_vs_model", "flag",
+]
+
+
+def _num(text: Optional[str]) -> Optional[float]:
+    try:
+        return float(text)
+    except (TypeError, ValueError):
+        return None
+
+
+def parse_cosim_report(path: str) -> Optional[Dict]:
+    with open(path, "r", errors="ignore") as f:
+        text = f.read()
+    for m in COSIM_ROW_RE.finditer(text):
+        rtl, status = m.group(1), m.group(2)
+        if status.upper() == "NA":
+            continue
+        values = [_num(v) for v in m.groups()[2:]]
+        keys = ["latency_min", "latency_avg", "latency_max",
+                "interval_min", "interval_avg", "interval_max", "total_cycles"]
+        row = {"rtl": rtl, "status": status}
+        row.update(dict(zip(keys, values)))
+        return row
+    return None
+
+
+def count_transactions(solution_dir: str) -> Dict[str, Optional[int]]:
+    """Transactions and data beats of the input stream as recorded by the cosim testbench."""
+    files = sorted(glob.glob(os.path.join(solution_dir, "sim", "tv", "cdatafile", "*autotvin*src*.dat")))
+    if not files:
+        return {"transactions": None, "input_beats": None}
+    with open(files[0], "r", errors="ignore") as f:
+        text = f.read()
+    beats = sum(1 for line in text.splitlines() if line.strip() and not line.startswith("[["))
+    return {"transactions": len(TRANSACTION_RE.findall(text)), "input_beats": beats}
+
+
+def csynth_performance(xml_path: str) -> Dict[str, Optional[float]]:
+    if not os.path.isfile(xml_path):
+        return {}
+    info = parse_csynth_xml(xml_path)
+    return {"csynth_latency": info.get("latency_worst"), "csynth_interval": info.get("interval_max")}
+
+
+def collect(projects_dir: str, tolerance: float) -> List[Dict]:
+    rows = []
+    for project_dir in sorted(glob.glob(os.path.join(projects_dir, "deconv_*"))):
+        if not os.path.isdir(project_dir):
+            continue
+        project = os.path.basename(project_dir)
+        for solution_dir in sorted(glob.glob(os.path.join(project_dir, "solution*"))):
+            solution = os.path.basename(solution_dir)
+            rpt = os.path.join(solution_dir, "sim", "report", "deconv_top_cosim.rpt")
+            design = design_from_names(project, solution)
+            if design is None or not os.path.isfile(rpt):
+                continue
+            measured = parse_cosim_report(rpt)
+            if measured is None:
+                continue
+
+            row = {"project": project, "solution": solution, "PE": design.PE, "SIMD": design.SIMD}
+            row.update(measured)
+            row.update(count_transactions(solution_dir))
+            if row["input_beats"] and design.supported():
+                row["frames"] = row["input_beats"] / design.input_beats()
+            row.update(csynth_performance(os.path.join(solution_dir, "syn", "report", "csynth.xml")))
+
+            # Steady-state interval if the RTL reported one, otherwise the
+            # execution time spread over all frames driven into the design.
+            cycles = row.get("interval_avg")
+            if cycles is None and row.get("total_cycles") and row.get("frames"):
+                cycles = round(row["total_cycles"] / row["frames"], 1)
+            if cycles is None:
+                cycles = row.get("latency_avg")
+            row["measured_cycles_per_frame"] = cycles
+
+            if design.supported():
+                model = design.cycles_per_frame()
+                row["model_cycles_per_frame"] = model
+                if cycles:
+                    ratio = cycles / model
+                    row["measured_vs_model"] = round(ratio, 3)
+                    row["flag"] = "OFF_MODEL" if abs(ratio - 1.0) > tolerance else "OK"
+            rows.append(row)
+    return rows
+
+
+def main(argv: List[str]) -> int:
+    p = argparse.ArgumentParser(description="Collect co-simulation latency/interval and compare with the cycle model.")
+    p.add_argument("--projects-dir", default="hls_projects", help="Root of generated HLS projects")
+    p.add_argument("--out-dir", help="Directory for the CSV summary (default: projects dir)")
+    p.add_argument("--tolerance", type=float, default=0.2, help="Relative deviation from the model to flag (default: 0.2)")
+    args = p.parse_args(argv)
+
+    if not os.path.isdir(args.projects_dir):
+        print(f"Error: projects directory not found: {args.projects_dir}")
+        return 1
+    out_dir = args.out_dir or args.projects_dir
+    os.makedirs(out_dir, exist_ok=True)
+
+    rows = collect(args.projects_dir, args.tolerance)
+    if not rows:
+        print("No co-simulation reports found (missing sim/report/deconv_top_cosim.rpt). Run cosim first.")
+        return 1
+
+    out_csv = os.path.join(out_dir, "cosim_summary.csv")
+    with open(out_csv, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS, extrasaction="ignore")
+        writer.writeheader()
+        for row in rows:
+            writer.writerow({k: ("" if row.get(k) is None else row[k]) for k in FIELDS})
+
+    off = [r for r in rows if r.get("flag") == "OFF_MODEL"]
+    print(f"{'Project':<40} {'Solution':<32} {'measured':>10} {'model':>10} {'ratio':>7}")
+    for r in rows:
+        mark = "  <-- OFF_MODEL" if r.get("flag") == "OFF_MODEL" else ""
+        print(f"{r['project']:<40} {r['solution']:<32} {str(r.get('measured_cycles_per_frame')):>10} "
+              f"{str(r.get('model_cycles_per_frame')):>10} {str(r.get('measured_vs_model')):>7}{mark}")
+    print(f"Co-simulation summary: {out_csv}")
+    print(f"Solutions off model (>{args.tolerance:.0%}): {len(off)} / {len(rows)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Clock Sweep Timing Collector
+============================
+
+Walks `hls_projects/deconv_*/solution*` and gathers, for every solution of the
+clock sweep created by `generate_hls_projects.tcl`:
+
+  - target clock period             (syn/report/csynth.xml)
+  - estimated clock period          (syn/report/csynth.xml)
+  - post-implementation period      (impl/report/verilog/*.rpt, if exported)
+  - resource estimates              (syn/report/csynth.xml)
+
+Each solution is combined with the analytical cycle model (`deconv_model.py`)
+to report the achievable throughput, i.e. output beats per cycle x Fmax,
+rather than cycle counts at a nominal clock.
+
+Outputs (in --projects-dir unless --out-dir is given):
+  - timing_summary.csv : one row per solution
+  - timing_best.csv    : best achievable frame rate per configuration
+
+Usage:
+  python collect_timing.py --projects-dir hls_projects
+"""
+from __future__ import annotations
+
+import argparse
+import csv
+import glob
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+from typing import Dict, List, Optional
+
+from deconv_model import clock_from_solution, design_from_names
+
+IMPL_CP_RE = re.compile(r"CP achieved post-implementation\s*\|?\s*([0-9.]+)")
+SYNTH_CP_RE = re.compile(r"CP achieved post-synthesis\s*\|?\s*([0-9.]+)")
+
+FIELDS = [
+    "project", "solution", "PE", "SIMD",
+    "target_ns", "estimated_ns", "post_synth_ns", "post_impl_ns", "achieved_ns", "fmax_mhz",
+    "cycles_per_frame", "beats_per_cycle", "mbeats_per_s", "frames_per_s",
+    "LUT", "FF", "DSP", "BRAM_18K", "URAM",
+]
+
+
+def _float(text: Optional[str]) -> Optional[float]:
+    try:
+        return float(text) if text is not None else None
+    except ValueError:
+        return None
+
+
+def parse_csynth_xml(path: str) -> Dict[str, Optional[float]]:
+    root = ET.parse(path).getroot()
+    info = {
+        "target_ns": _float(root.findtext("UserAssignments/TargetClockPeriod")),
+        "estimated_ns": _float(root.findtext("PerformanceEstimates/SummaryOfTimingAnalysis/EstimatedClockPeriod")),
+        # Undefined ("undef") for the free-running ap_ctrl_none top level
+        "latency_worst": _float(root.findtext("PerformanceEstimates/SummaryOfOverallLatency/Worst-caseLatency")),
+        "interval_max": _float(root.findtext("PerformanceEstimates/SummaryOfOverallLatency/Interval-max")),
+    }
+    for res in ("LUT", "FF", "DSP", "BRAM_18K", "URAM"):
+        value = _float(root.findtext(f"AreaEstimates/Resources/{res}"))
+        info[res] = int(value) if value is not None else None
+    return info
+
+
+def parse_impl_reports(solution_dir: str) -> Dict[str, Optional[float]]:
+    info = {"post_synth_ns": None, "post_impl_ns": None}
+    reports = glob.glob(os.path.join(solution_dir, "impl", "report", "verilog", "*.rpt")) + \
+              glob.glob(os.path.join(solution_dir, "impl", "verilog", "report", "*.rpt"))
+    for rpt in reports:
+        with open(rpt, "r", errors="ignore") as f:
+            text = f.read()
+        m = IMPL_CP_RE.search(text)
+        if m and info["post_impl_ns"] is None:
+            info["post_impl_ns"] = float(m.group(1))
+        m = SYNTH_CP_RE.search(text)
+        if m and info["post_synth_ns"] is None:
+            info["post_synth_ns"] = float(m.group(1))
+    return info
+
+
+def collect(projects_dir: str) -> List[Dict]:
+    rows = []
+    for project_dir in sorted(glob.glob(os.path.join(projects_dir, "deconv_*"))):
+        if not os.path.isdir(project_dir):
+            continue
+        project = os.path.basename(project_dir)
+        for solution_dir in sorted(glob.glob(os.path.join(project_dir, "solution*"))):
+            solution = os.path.basename(solution_dir)
+            design = design_from_names(project, solution)
+            xml_path = os.path.join(solution_dir, "syn", "report", "csynth.xml")
+            if design is None or not os.path.isfile(xml_path):
+                continue
+
+            row = {"project": project, "solution": solution, "PE": design.PE, "SIMD": design.SIMD}
+            row.update(parse_csynth_xml(xml_path))
+            row.update(parse_impl_reports(solution_dir))
+            if row["target_ns"] is None:
+                row["target_ns"] = clock_from_solution(solution)
+
+            # Most trustworthy period available: implementation > synthesis > HLS estimate
+            achieved = row["post_impl_ns"] or row["post_synth_ns"] or row["estimated_ns"]
+            row["achieved_ns"] = achieved
+            if achieved and design.supported():
+                fmax = 1e3 / achieved
+                row["fmax_mhz"] = round(fmax, 2)
+                row["cycles_per_frame"] = design.cycles_per_frame()
+                row["beats_per_cycle"] = round(design.beats_per_cycle(), 4)
+                row["mbeats_per_s"] = round(design.beats_per_cycle() * fmax, 2)
+                row["frames_per_s"] = round(design.frames_per_second(fmax), 1)
+            rows.append(row)
+    return rows
+
+
+def best_per_config(rows: List[Dict]) -> List[Dict]:
+    best: Dict[str, Dict] = {}
+    for row in rows:
+        if row.get("frames_per_s") is None:
+            continue
+        cur = best.get(row["project"])
+        if cur is None or row["frames_per_s"] > cur["frames_per_s"]:
+            best[row["project"]] = row
+    return [best[k] for k in sorted(best)]
+
+
+def write_csv(path: str, rows: List[Dict]) -> None:
+    with open(path, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS, extrasaction="ignore")
+        writer.writeheader()
+        for row in rows:
+            writer.writerow({k: ("" if row.get(k) is None else row[k]) for k in FIELDS})
+
+
+def main(argv: List[str]) -> int:
+    p = argparse.ArgumentParser(description="Collect clock sweep timing and achievable throughput.")
+    p.add_argument("--projects-dir", default="hls_projects", help="Root of generated HLS projects")
+    p.add_argument("--out-dir", help="Directory for CSV summaries (default: projects dir)")
+    args = p.parse_args(argv)
+
+    if not os.path.isdir(args.projects_dir):
+        print(f"Error: projects directory not found: {args.projects_dir}")
+        return 1
+    out_dir = args.out_dir or args.projects_dir
+    os.makedirs(out_dir, exist_ok=True)
+
+    rows = collect(args.projects_dir)
+    if not rows:
+        print("No synthesized solutions found (missing syn/report/csynth.xml). Run synthesis first.")
+        return 1
+    best = best_per_config(rows)
+
+    write_csv(os.path.join(out_dir, "timing_summary.csv"), rows)
+    write_csv(os.path.join(out_dir, "timing_best.csv"), best)
+
+    print(f"{'Project':<40} {'Solution':<32} {'ns':>6} {'MHz':>8} {'beats/cyc':>10} {'Mbeats/s':>10} {'frames/s':>12}")
+    for row in best:
+        print(f"{row['project']:<40} {row['solution']:<32} {row['achieved_ns']:>6} "
+              f"{row['fmax_mhz']:>8} {row['beats_per_cycle']:>10} {row['mbeats_per_s']:>10} {row['frames_per_s']:>12}")
+    print(f"Timing summary: {os.path.join(out_dir, 'timing_summary.csv')}")
+    print(f"Best per config: {os.path.join(out_dir, 'timing_best.csv')}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
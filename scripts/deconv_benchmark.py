@@ -1,7 +1,7 @@
 #!/usr/bin/env python3
 """
-PyTorch Deconvolution (ConvTranspose2d) Benchmark Data Generator
-===============================================================
+PyTorch Deconvolution (ConvTranspose2d/1d) Benchmark Data Generator
+==================================================================
 
 This script replicates and extends the functionality of the Jupyter notebook
 `deconv_pytorch.ipynb` by generating synthetic input, weight, and output data
@@ -10,6 +10,7 @@ in a JSON parameter space file.
 
 Outputs:
   - configs/deconv_configs.csv : CSV listing all tested parameter combinations.
+  - manifest.json              : Dataset key and files of every generated configuration.
   - exp_data/*_input.csv       : Flattened input tensor values.
   - exp_data/*_weights.csv     : Flattened weight tensor values.
   - exp_data/*_output.csv      : Flattened output tensor values (channel-last order).
@@ -24,7 +25,29 @@ JSON Parameter Space Format (example `parameter_space.json`):
   "stride":       [1],
   "padding":      [1, 2]
 }
-Keys become Cartesian product dimensions.
+Keys become Cartesian product dimensions. Optional keys for asymmetric layers:
+  "padding_bottom", "padding_left", "padding_right"  (default: "padding", which
+  then is the top padding) and "output_padding" (default: 0, applied to the
+  bottom and right edges like ConvTranspose2d's output_padding). TensorFlow
+  "SAME" transposed convolutions (output = S*input) use padding = (K-S)//2 and
+  padding_bottom = padding_right = (K-S) - (K-S)//2.
+  "dilation" (default: 1) spaces the kernel taps D apart like ConvTranspose2d's
+  dilation; the output grows by (D-1)*(K-1). The hardware requires D coprime
+  to the stride.
+  "resize" (default: "") selects the resize-convolution alternative instead of
+  ConvTranspose2d: "nearest" or "bilinear" upsampling by `stride` followed by a
+  stride-1 Conv2d with the given (per-edge) zero padding. Bilinear outputs are
+  scaled by (2*stride)^2 to keep them integral, as computed by the hardware.
+  "sparsity" (default: "") prunes the weights to N:M structured sparsity along
+  the input channels, e.g. "2:4": of every M consecutive input channels at a
+  kernel tap and output channel, only the N largest magnitudes stay nonzero.
+  in_channels must be a multiple of M.
+  "dims" (default: 2) selects ConvTranspose1d with dims = 1, e.g. for the
+  upsampling layers of audio vocoders: input_size is then the sequence length,
+  "padding" and "padding_right" the left and right (de)padding, and
+  "padding_bottom"/"padding_left" are ignored. Data sets are named
+  deconv_<L>x1_..., the layout of a 1 x L feature map. Dilation, resize and
+  sparsity are 2D only.
 
 CLI Usage:
   python deconv_benchmark.py \
@@ -33,8 +56,7 @@ CLI Usage:
       --seed 42 \
       --input-range 0 1 \
       --weight-range 0 255 \
-      --device cpu \
-      --no-clean
+      --device cpu
 
 Options:
   --param-file    Path to JSON parameter space (required).
@@ -44,16 +66,33 @@ Options:
   --weight-range  Two ints: inclusive low high for weight tensor values (default: 0 255).
   --device        Torch device (cpu / cuda) (default: cpu).
   --bias          Include bias in layer (default: False like notebook; if True, saves *_bias.csv and bias shape).
-  --clean / --no-clean  Remove existing output directory before generation (default: --clean).
+  --precision     Floating-point type of the reference computation: float32 / float64 (default: float32).
+  --clean / --no-clean  Remove existing output directory before generation (default: --no-clean).
+  --force         Regenerate every configuration even if its data set is up to date.
+  --prune         Delete data sets of configurations no longer in the parameter space.
   --limit         Optional int to limit number of configurations processed (debugging).
   --dry-run       List configurations without generating tensors.
   --verbose       Extra logging.
 
+Incremental Generation:
+  Every data set is addressed by a key hashed from its configuration, the seed,
+  both value ranges, the precision and the bias flag. Each configuration draws
+  its tensors from its own generator seeded by that key, so its data do not
+  depend on the other configurations of the sweep or their order. The keys
+  and files are recorded in <out-dir>/manifest.json. A rerun regenerates only
+  configurations whose key changed or whose files are missing. Adding one
+  layer to a large sweep therefore generates one data set.
+
 Notes:
   - Input tensors and weights are sampled with torch.randint in the specified ranges.
-  - Output tensor is saved in channel-last flattened order: (H_out, W_out, out_channels).
+  - Output tensor is saved in channel-last flattened order: (H_out, W_out, out_channels),
+    (L_out, out_channels) for 1D layers.
   - Bias disabled by default (original notebook used bias=False for layer construction).
   - Shapes CSV encodes dimensions using 'x' separators.
+  - Asymmetric padding is not expressible in ConvTranspose2d, and it rejects
+    output_padding >= max(stride, dilation); such layers and all layers with
+    output_padding run with padding=0 and the full output is cropped per edge
+    (and zero-extended by output_padding) before saving.
 
 Future improvements (not implemented):
   - Parallel generation via multiprocessing.
@@ -63,13 +102,15 @@ Future improvements (not implemented):
 from __future__ import annotations
 
 import argparse
+import hashlib
 import itertools
 import json
+import math
 import os
 import shutil
 import sys
 from dataclasses import dataclass
-from typing import Dict, List, Tuple
+from typing import Dict, List, Optional, Tuple
 
 import torch
 import torch.nn as nn
@@ -87,6 +128,35 @@ class DeconvConfig:
     kernel_size: int
     stride: int
     padding: int
+    padding_bottom: Optional[int] = None
+    padding_left: Optional[int] = None
+    padding_right: Optional[int] = None
+    output_padding: int = 0
+    dilation: int = 1
+    resize: str = ""
+    sparsity: str = ""
+    dims: int = 2
+
+    def __post_init__(self) -> None:
+        for edge in ("padding_bottom", "padding_left", "padding_right"):
+            if getattr(self, edge) is None:
+                setattr(self, edge, self.padding)
+        if self.dims == 1:
+            # A sequence has a left ("padding") and a right edge only
+            self.padding_bottom = self.padding_left = self.padding
+
+    @property
+    def symmetric(self) -> bool:
+        return self.padding == self.padding_bottom == self.padding_left == self.padding_right
+
+    @property
+    def cropped(self) -> bool:
+        """Whether the output is cropped from the full (padding=0) transposed convolution.
+
+        ConvTranspose2d only takes symmetric padding and rejects
+        output_padding >= max(stride, dilation), e.g. S=1 with OP=1.
+        """
+        return not self.symmetric or self.output_padding != 0
 
     def to_dict(self) -> Dict[str, int]:
         return {
@@ -96,15 +166,62 @@ class DeconvConfig:
             "kernel_size": self.kernel_size,
             "stride": self.stride,
             "padding": self.padding,
+            "padding_bottom": self.padding_bottom,
+            "padding_left": self.padding_left,
+            "padding_right": self.padding_right,
+            "output_padding": self.output_padding,
+            "dilation": self.dilation,
+            "resize": self.resize,
+            "sparsity": self.sparsity,
+            "dims": self.dims,
         }
 
+    @property
+    def nm(self) -> Tuple[int, int]:
+        """(N, M) of the structured sparsity, (1, 1) for dense layers."""
+        if not self.sparsity:
+            return 1, 1
+        n, m = (int(v) for v in self.sparsity.split(":"))
+        return n, m
+
+    def padding_suffix(self) -> str:
+        """Name suffix for non-default edges, dilation, resize engines and sparsity; empty for plain symmetric layers."""
+        suffix = ""
+        if not self.symmetric:
+            suffix += f"_pb{self.padding_bottom}_pl{self.padding_left}_pr{self.padding_right}"
+        if self.output_padding:
+            suffix += f"_op{self.output_padding}"
+        if self.dilation != 1:
+            suffix += f"_d{self.dilation}"
+        if self.resize:
+            suffix += f"_{RESIZE_TAGS[self.resize]}{self.stride}"
+        if self.sparsity:
+            n, m = self.nm
+            suffix += f"_nm{n}of{m}"
+        return suffix
+
     def base_filename(self, root: str) -> str:
+        height = 1 if self.dims == 1 else self.input_size
         return os.path.join(
             root,
             "exp_data",
-            f"deconv_{self.input_size}x{self.input_size}_in{self.in_channels}_out{self.out_channels}_k{self.kernel_size}_s{self.stride}_p{self.padding}",
+            f"deconv_{self.input_size}x{height}_in{self.in_channels}_out{self.out_channels}_k{self.kernel_size}_s{self.stride}_p{self.padding}{self.padding_suffix()}",
         )
 
+    def dataset_key(self, seed: int, input_range: Tuple[int, int], weight_range: Tuple[int, int],
+                    precision: str, bias: bool) -> str:
+        """Content address of the data set generated for this configuration."""
+        ident = {
+            "version": MANIFEST_VERSION,
+            "config": self.to_dict(),
+            "seed": seed,
+            "input_range": list(input_range),
+            "weight_range": list(weight_range),
+            "precision": precision,
+            "bias": bias,
+        }
+        return hashlib.sha256(json.dumps(ident, sort_keys=True).encode()).hexdigest()[:16]
+
 # ---------------------------------------------------------------------------
 # Core functionality
 # ---------------------------------------------------------------------------
@@ -120,14 +237,41 @@ def load_parameter_space(path: str) -> Dict[str, List[int]]:
     return data
 
 
+MANIFEST_NAME = "manifest.json"
+MANIFEST_VERSION = 1
+PRECISIONS = {"float32": torch.float32, "float64": torch.float64}
+OPTIONAL_KEYS = ["padding_bottom", "padding_left", "padding_right", "output_padding", "dilation", "resize",
+                 "sparsity", "dims"]
+RESIZE_TAGS = {"nearest": "nn", "bilinear": "bl"}
+
+
 def enumerate_configs(parameter_space: Dict[str, List[int]]) -> List[DeconvConfig]:
     required_keys = ["input_size", "in_channels", "out_channels", "kernel_size", "stride", "padding"]
     for k in required_keys:
         if k not in parameter_space:
             raise KeyError(f"Missing required parameter key: {k}")
-    names = required_keys
+    names = required_keys + [k for k in OPTIONAL_KEYS if k in parameter_space]
     values = [parameter_space[k] for k in names]
-    configs = [DeconvConfig(*combo) for combo in itertools.product(*values)]
+    configs = []
+    seen = set()
+    for combo in itertools.product(*values):
+        cfg = DeconvConfig(**dict(zip(names, combo)))
+        # 1D layers ignore padding_bottom/padding_left, which may repeat them
+        ident = tuple(cfg.to_dict().values())
+        if ident not in seen:
+            seen.add(ident)
+            configs.append(cfg)
+    for cfg in configs:
+        if cfg.dims not in (1, 2) or (cfg.dims == 1 and (cfg.dilation != 1 or cfg.resize or cfg.sparsity)):
+            raise ValueError(f"Unsupported dims configuration: {cfg}")
+        if cfg.resize and (cfg.resize not in RESIZE_TAGS or cfg.output_padding or cfg.dilation != 1):
+            raise ValueError(f"Unsupported resize configuration: {cfg}")
+        if cfg.dilation < 1 or math.gcd(cfg.dilation, cfg.stride) != 1:
+            raise ValueError(f"Unsupported dilation configuration: {cfg}")
+        if cfg.sparsity:
+            n, m = cfg.nm
+            if cfg.resize or not 0 < n < m or cfg.in_channels % m:
+                raise ValueError(f"Unsupported sparsity configuration: {cfg}")
     return configs
 
 
@@ -135,33 +279,90 @@ def write_configs_csv(path: str, configs: List[DeconvConfig]) -> None:
     os.makedirs(os.path.dirname(path), exist_ok=True)
     with open(path, "w", newline="") as f:
         writer = csv.DictWriter(f, fieldnames=[
-            "input_size", "in_channels", "out_channels", "kernel_size", "stride", "padding"
+            "input_size", "in_channels", "out_channels", "kernel_size", "stride", "padding",
+            *OPTIONAL_KEYS,
         ])
         writer.writeheader()
         for cfg in configs:
             writer.writerow(cfg.to_dict())
 
 
-def init_layer(cfg: DeconvConfig, bias: bool, device: torch.device) -> nn.ConvTranspose2d:
-    layer = nn.ConvTranspose2d(
+def init_layer(cfg: DeconvConfig, bias: bool, device: torch.device) -> nn.Module:
+    # Asymmetric and output-padded layers compute the full output, cropped by crop_edges()
+    conv = nn.ConvTranspose1d if cfg.dims == 1 else nn.ConvTranspose2d
+    layer = conv(
         in_channels=cfg.in_channels,
         out_channels=cfg.out_channels,
         kernel_size=cfg.kernel_size,
         stride=cfg.stride,
-        padding=cfg.padding,
-        output_padding=0,
-        dilation=1,
+        padding=0 if cfg.cropped else cfg.padding,
+        dilation=cfg.dilation,
         groups=1,
         bias=bias,
     ).to(device)
     return layer
 
 
-def gen_tensor_int(shape: Tuple[int, ...], low: int, high: int, device: torch.device) -> torch.Tensor:
-    # torch.randint is exclusive on high, so add 1 for inclusive semantics
+def init_resize_conv(cfg: DeconvConfig, bias: bool, device: torch.device) -> nn.Conv2d:
+    # Zero padding is applied per edge by resize_conv_forward()
+    layer = nn.Conv2d(
+        in_channels=cfg.in_channels,
+        out_channels=cfg.out_channels,
+        kernel_size=cfg.kernel_size,
+        stride=1,
+        padding=0,
+        bias=bias,
+    ).to(device)
+    return layer
+
+
+def resize_conv_forward(cfg: DeconvConfig, layer: nn.Conv2d, x: torch.Tensor) -> torch.Tensor:
+    """Upsample by `stride`, zero-pad per edge and convolve (N, C, H, W)."""
+    if cfg.resize == "bilinear":
+        scale = (2 * cfg.stride) ** 2
+        up = torch.round(nn.functional.interpolate(x, scale_factor=cfg.stride, mode="bilinear",
+                                                   align_corners=False) * scale)
+    else:
+        up = nn.functional.interpolate(x, scale_factor=cfg.stride, mode="nearest")
+    up = nn.functional.pad(up, (cfg.padding_left, cfg.padding_right, cfg.padding, cfg.padding_bottom))
+    return layer(up)
+
+
+def prune_nm(cfg: DeconvConfig, weight: torch.Tensor) -> torch.Tensor:
+    """Zero all but the N largest magnitudes of every M consecutive input channels.
+
+    `weight` is the ConvTranspose2d layout (CI, CO, K, K); ties keep the lower channel.
+    """
+    n, m = cfg.nm
+    ci, co, kh, kw = weight.shape
+    groups = weight.reshape(ci // m, m, co, kh, kw)
+    order = torch.argsort(-groups.abs(), dim=1, stable=True)
+    keep = torch.zeros_like(groups, dtype=torch.bool).scatter_(1, order[:, :n], True)
+    return (groups * keep).reshape(ci, co, kh, kw)
+
+
+def crop_edges(cfg: DeconvConfig, full: torch.Tensor) -> torch.Tensor:
+    """Per-edge crop of a full (padding=0) transposed convolution output (N, C, H, W) or (N, C, L).
+
+    Output padding extends the bottom/right edges with zeros where no input
+    contributes, matching ConvTranspose2d's output_padding semantics.
+    """
+    op = cfg.output_padding
+    if cfg.dims == 1:
+        full = torch.nn.functional.pad(full, (0, op))
+        return full[..., cfg.padding:full.shape[-1] - cfg.padding_right]
+    full = torch.nn.functional.pad(full, (0, op, 0, op))
+    h, w = full.shape[-2:]
+    return full[..., cfg.padding:h - cfg.padding_bottom, cfg.padding_left:w - cfg.padding_right]
+
+
+def gen_tensor_int(shape: Tuple[int, ...], low: int, high: int, device: torch.device,
+                   generator: torch.Generator, dtype: torch.dtype = torch.float32) -> torch.Tensor:
+    # torch.randint is exclusive on high, so add 1 for inclusive semantics.
+    # Sampled on the CPU generator so that data are identical on every device.
     if low > high:
         raise ValueError("low cannot be greater than high")
-    return torch.randint(low, high + 1, shape, dtype=torch.int32, device=device).to(torch.float32)
+    return torch.randint(low, high + 1, shape, dtype=torch.int32, generator=generator).to(device=device, dtype=dtype)
 
 
 def save_flat_csv(path: str, tensor: torch.Tensor) -> None:
@@ -174,6 +375,43 @@ def save_shapes_csv(path: str, shapes: Dict[str, Tuple[int, ...]]) -> None:
         for name, shape in shapes.items():
             f.write(f"{name},{'x'.join(str(d) for d in shape)}\n")
 
+def load_manifest(out_dir: str) -> Dict[str, Dict]:
+    path = os.path.join(out_dir, MANIFEST_NAME)
+    if not os.path.isfile(path):
+        return {}
+    with open(path, "r") as f:
+        data = json.load(f)
+    if data.get("version") != MANIFEST_VERSION:
+        print(f"Ignoring manifest of version {data.get('version')}: {path}")
+        return {}
+    return data.get("datasets", {})
+
+
+def save_manifest(out_dir: str, datasets: Dict[str, Dict]) -> None:
+    path = os.path.join(out_dir, MANIFEST_NAME)
+    tmp = path + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump({"version": MANIFEST_VERSION, "datasets": datasets}, f, indent=1, sort_keys=True)
+    os.replace(tmp, path)
+
+
+def dataset_current(entry: Optional[Dict], key: str, exp_dir: str) -> bool:
+    """True if the manifest entry has the key and all of its files still exist."""
+    return (entry is not None and entry.get("key") == key
+            and all(os.path.isfile(os.path.join(exp_dir, f)) for f in entry.get("files", [])))
+
+
+def prune_datasets(datasets: Dict[str, Dict], keep: List[str], exp_dir: str) -> int:
+    """Remove data sets (files and manifest entries) whose name is not in `keep`."""
+    stale = [name for name in datasets if name not in set(keep)]
+    for name in stale:
+        for f in datasets.pop(name).get("files", []):
+            path = os.path.join(exp_dir, f)
+            if os.path.isfile(path):
+                os.remove(path)
+        print(f"Pruned data set: {name}")
+    return len(stale)
+
 # ---------------------------------------------------------------------------
 # Generation loop
 # ---------------------------------------------------------------------------
@@ -186,86 +424,145 @@ def generate_data(
     seed: int,
     device_str: str,
     bias: bool,
+    precision: str = "float32",
     limit: int | None = None,
     dry_run: bool = False,
     verbose: bool = False,
+    force: bool = False,
+    prune: bool = False,
 ) -> None:
+    sweep = [os.path.basename(cfg.base_filename(out_dir)) for cfg in configs]
     if limit is not None:
         configs = configs[:limit]
     device = torch.device(device_str)
-    torch.manual_seed(seed)
-    np.random.seed(seed)
+    dtype = PRECISIONS[precision]
+    exp_dir = os.path.join(out_dir, "exp_data")
 
     # Prepare directories
     configs_csv = os.path.join(out_dir, "configs", "deconv_configs.csv")
     write_configs_csv(configs_csv, configs)
-    os.makedirs(os.path.join(out_dir, "exp_data"), exist_ok=True)
+    os.makedirs(exp_dir, exist_ok=True)
     print(f"Saved configuration table: {configs_csv}")
 
+    datasets = load_manifest(out_dir)
+    keys = [cfg.dataset_key(seed, input_range, weight_range, precision, bias) for cfg in configs]
+    names = [os.path.basename(cfg.base_filename(out_dir)) for cfg in configs]
+    todo = [force or not dataset_current(datasets.get(n), k, exp_dir) for n, k in zip(names, keys)]
+
     if dry_run:
         print("Dry-run: listing configurations only (no tensors generated).")
-        for i, cfg in enumerate(configs, 1):
-            print(f"[{i}/{len(configs)}] {cfg}")
+        for i, (cfg, gen) in enumerate(zip(configs, todo), 1):
+            print(f"[{i}/{len(configs)}] {'generate' if gen else 'current '} {cfg}")
         return
 
     total = len(configs)
-    for idx, cfg in enumerate(configs, 1):
-        if verbose:
-            print(f"Preparing data for configuration {idx}/{total}: {cfg}")
-        base = cfg.base_filename(out_dir)
-
-        # Initialize layer
+    generated = 0
+    try:
+        for idx, (cfg, key, name, gen) in enumerate(zip(configs, keys, names, todo), 1):
+            if not gen:
+                if verbose:
+                    print(f"[{idx}/{total}] {name} is current ({key})")
+                continue
+            generate_dataset(cfg, out_dir, key, input_range, weight_range, device, dtype, bias, verbose)
+            files = [f"{name}_{kind}.csv" for kind in ("input", "weights", "output", "shapes")]
+            if bias:
+                files.append(f"{name}_bias.csv")
+            datasets[name] = {
+                "key": key,
+                "config": cfg.to_dict(),
+                "seed": seed,
+                "input_range": list(input_range),
+                "weight_range": list(weight_range),
+                "precision": precision,
+                "bias": bias,
+                "files": files,
+            }
+            generated += 1
+            print(f"[{idx}/{total}] {name}")
+        if prune:
+            prune_datasets(datasets, sweep, exp_dir)
+    finally:
+        save_manifest(out_dir, datasets)
+
+    print(f"Generation complete: {generated} generated, {total - generated} current. Data root: {out_dir}")
+
+
+def generate_dataset(
+    cfg: DeconvConfig,
+    out_dir: str,
+    key: str,
+    input_range: Tuple[int, int],
+    weight_range: Tuple[int, int],
+    device: torch.device,
+    dtype: torch.dtype,
+    bias: bool,
+    verbose: bool = False,
+) -> None:
+    """Generate and save the tensors of one configuration from its own generator."""
+    base = cfg.base_filename(out_dir)
+    generator = torch.Generator().manual_seed(int(key, 16) & 0x7FFFFFFFFFFFFFFF)
+    if verbose:
+        print(f"Preparing data for configuration {cfg} (key {key})")
+
+    # Initialize layer
+    if cfg.resize:
+        layer = init_resize_conv(cfg, bias=bias, device=device)
+    else:
         layer = init_layer(cfg, bias=bias, device=device)
-
-        # Overwrite weights and (optional) bias with random ints
-        with torch.no_grad():
-            weight_tensor = gen_tensor_int(tuple(layer.weight.shape), *weight_range, device=device)
-            layer.weight.copy_(weight_tensor)
-            if bias and layer.bias is not None:
-                bias_tensor = gen_tensor_int(tuple(layer.bias.shape), *weight_range, device=device)
-                layer.bias.copy_(bias_tensor)
-
-        # Generate input tensor
-        input_tensor = gen_tensor_int((1, cfg.in_channels, cfg.input_size, cfg.input_size), *input_range, device=device)
-
-        # Forward pass
-        with torch.no_grad():
-            output_tensor = layer(input_tensor)
-
-        # Save tensors
-        save_flat_csv(f"{base}_input.csv", input_tensor)
-        save_flat_csv(f"{base}_weights.csv", layer.weight)
+    layer = layer.to(dtype)
+
+    # Overwrite weights and (optional) bias with random ints
+    with torch.no_grad():
+        weight_tensor = gen_tensor_int(tuple(layer.weight.shape), *weight_range, device, generator, dtype)
+        if cfg.sparsity:
+            weight_tensor = prune_nm(cfg, weight_tensor)
+        layer.weight.copy_(weight_tensor)
         if bias and layer.bias is not None:
-            save_flat_csv(f"{base}_bias.csv", layer.bias)
+            bias_tensor = gen_tensor_int(tuple(layer.bias.shape), *weight_range, device, generator, dtype)
+            layer.bias.copy_(bias_tensor)
 
-        # Output rearranged to (H_out, W_out, C_out) then flattened
-        out_rearranged = output_tensor.detach().squeeze(0).permute(1, 2, 0).contiguous()
-        save_flat_csv(f"{base}_output.csv", out_rearranged)
+    # Generate input tensor
+    spatial = (cfg.input_size,) * cfg.dims
+    input_tensor = gen_tensor_int((1, cfg.in_channels, *spatial), *input_range, device, generator, dtype)
 
-        # Shapes CSV
-        shapes = {
-            "input_shape": tuple(input_tensor.shape),
-            "weights_shape": tuple(layer.weight.shape),
-            "output_shape": tuple(output_tensor.shape),
-        }
-        if bias and layer.bias is not None:
-            shapes["bias_shape"] = tuple(layer.bias.shape)
-        save_shapes_csv(f"{base}_shapes.csv", shapes)
-
-        if verbose:
-            print(f"Saved data set: {base}")
+    # Forward pass
+    with torch.no_grad():
+        if cfg.resize:
+            output_tensor = resize_conv_forward(cfg, layer, input_tensor)
         else:
-            # lightweight progress indicator
-            print(f"[{idx}/{total}] {base.split(os.sep)[-1]}")
-
-    print(f"Generation complete. Data root: {out_dir}")
+            output_tensor = layer(input_tensor)
+            if cfg.cropped:
+                output_tensor = crop_edges(cfg, output_tensor)
+
+    # Save tensors
+    save_flat_csv(f"{base}_input.csv", input_tensor)
+    save_flat_csv(f"{base}_weights.csv", layer.weight)
+    if bias and layer.bias is not None:
+        save_flat_csv(f"{base}_bias.csv", layer.bias)
+
+    # Output rearranged to (H_out, W_out, C_out) or (L_out, C_out) then flattened
+    out_rearranged = output_tensor.detach().squeeze(0).movedim(0, -1).contiguous()
+    save_flat_csv(f"{base}_output.csv", out_rearranged)
+
+    # Shapes CSV
+    shapes = {
+        "input_shape": tuple(input_tensor.shape),
+        "weights_shape": tuple(layer.weight.shape),
+        "output_shape": tuple(output_tensor.shape),
+    }
+    if bias and layer.bias is not None:
+        shapes["bias_shape"] = tuple(layer.bias.shape)
+    save_shapes_csv(f"{base}_shapes.csv", shapes)
+
+    if verbose:
+        print(f"Saved data set: {base}")
 
 # ---------------------------------------------------------------------------
 # Argument parsing
 # ---------------------------------------------------------------------------
 
 def parse_args(argv: List[str]) -> argparse.Namespace:
-    p = argparse.ArgumentParser(description="Generate benchmark data for ConvTranspose2d parameter sweeps.")
+    p = argparse.ArgumentParser(description="Generate benchmark data for ConvTranspose2d/1d parameter sweeps.")
     p.add_argument("--param-file", required=True, help="JSON file defining parameter space")
     p.add_argument("--out-dir", default="deconv_data", help="Root output directory")
     p.add_argument("--seed", type=int, default=1234, help="Random seed")
@@ -273,9 +570,12 @@ def parse_args(argv: List[str]) -> argparse.Namespace:
     p.add_argument("--weight-range", nargs=2, type=int, default=[0, 255], metavar=("LOW", "HIGH"), help="Inclusive range for weight (and bias) values")
     p.add_argument("--device", default="cpu", choices=["cpu", "cuda"], help="Torch device")
     p.add_argument("--bias", action="store_true", help="Include bias in layer and save bias data")
-    p.add_argument("--clean", dest="clean", action="store_true", help="Remove existing output directory before generation (default)")
-    p.add_argument("--no-clean", dest="clean", action="store_false", help="Do not remove existing output directory before generation")
-    p.set_defaults(clean=True)
+    p.add_argument("--precision", default="float32", choices=sorted(PRECISIONS), help="Floating-point type of the reference computation")
+    p.add_argument("--clean", dest="clean", action="store_true", help="Remove existing output directory before generation")
+    p.add_argument("--no-clean", dest="clean", action="store_false", help="Keep existing data sets and regenerate only stale ones (default)")
+    p.set_defaults(clean=False)
+    p.add_argument("--force", action="store_true", help="Regenerate every configuration even if its data set is up to date")
+    p.add_argument("--prune", action="store_true", help="Delete data sets of configurations no longer in the parameter space")
     p.add_argument("--limit", type=int, help="Limit number of configurations processed (debug)")
     p.add_argument("--dry-run", action="store_true", help="Only list configurations, do not generate tensors")
     p.add_argument("--verbose", action="store_true", help="Verbose logging")
@@ -306,9 +606,12 @@ def main(argv: List[str]) -> None:
         seed=args.seed,
         device_str=args.device,
         bias=args.bias,
+        precision=args.precision,
         limit=args.limit,
         dry_run=args.dry_run,
         verbose=args.verbose,
+        force=args.force,
+        prune=args.prune,
     )
 
 
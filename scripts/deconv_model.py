@@ -0,0 +1,379 @@
+#!/usr/bin/env python3
+"""
+Analytical Cycle Model for the Streaming Deconvolution Pipeline
+===============================================================
+
+Mirrors the compile-time derivations of `deconv()` in `src/deconv.hpp` so that
+scripts can reason about a configuration without running HLS:
+
+  deconv_swg (virtual padding) -> deconv_mvu -> crop
+
+of its conv + depth-to-space rewrite `deconv_d2s()`, whose S*S phase replays
+become S*S*CO/PE channel groups of a stride-1 window generator, for the same
+number of window beats and cycles:
+
+  deconv_swg<K/S, 1> -> deconv_mvu -> depth_to_space -> crop
+
+and of the resize-convolution alternative `resize_conv()` in
+`src/resize_conv.hpp` (upsampling by S, then a stride-1 convolution):
+
+  resize_nearest | resize_bilinear x2 -> deconv_swg<K, 1> -> deconv_mvu
+
+and of the MM2IM engine `mm2im()` in `src/mm2im.hpp` (per-pixel matrix
+multiplication, then col2im overlap-add of the uncropped output):
+
+  mm2im_replay -> deconv_mvu -> col2im
+
+`deconv_mvu` retires one `swg` beat per cycle, which makes the number of
+window beats emitted by `deconv_swg` (or `mm2im_replay`) the steady-state
+cycle count per frame.
+In batch mode (DECONV_BATCH = B) a frame carries B interleaved images: all
+activation beat counts scale by B, while the weight stream is read once per
+frame, i.e. once per B images.
+Output-tile blocking (DECONV_TILE_X/_Y = TX/TY, `deconv_tiled()`) applies each
+weight beat to a TX x TY tile of window positions, extended to whole tiles at
+the bottom/right edge: the weight stream shrinks by TX*TY, the window beats
+only grow by the extension.
+A kernel dilated by D (coprime to S) keeps its K/S x K/S taps per window, but
+the windows span KW = D*(K/S-1) + skew + 1 input rows and columns (see
+`deconv_dilation` in `src/deconv.hpp`), so that the window positions and the
+output grow with D while the beats per window do not.
+
+The 1D transposed convolution `deconv1d()` in `src/deconv1d.hpp` (H = 1,
+padding P left and PR right) replays windows of ceil(K/S) input samples, one
+per window position covering the cropped output:
+
+  deconv1d_swg -> deconv_mvu -> crop
+
+Usage (CLI):
+  python deconv_model.py --K 4 --S 2 --H 6 --W 6 --CI 1 --CO 2 --P 2 --PE 1 --SIMD 1
+"""
+from __future__ import annotations
+
+import argparse
+import math
+import re
+import sys
+from dataclasses import dataclass
+from typing import Dict, Optional
+
+
+# Project / solution naming used by generate_hls_projects.tcl
+PROJECT_RE = re.compile(r"deconv_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)((?:_[A-Z]+\d+(?:of\d+)?)*)")
+EDGE_RE = re.compile(r"_([A-Z]+)(\d+)(?:of(\d+))?")
+RESIZE_TAGS = {"NN": "nearest", "BL": "bilinear"}
+SOLUTION_RE = re.compile(r"solution(\d+)_PE(\d+)_SIMD(\d+)(?:_CLK([0-9p]+))?")
+
+
+@dataclass
+class DeconvDesign:
+    K: int
+    S: int
+    H: int
+    W: int
+    CI: int
+    CO: int
+    P: int
+    PE: int = 1
+    SIMD: int = 1
+    PB: Optional[int] = None    # bottom/left/right (de)padding, default: P (top)
+    PL: Optional[int] = None
+    PR: Optional[int] = None
+    OPH: int = 0                # output padding below / right of the output
+    OPW: int = 0
+    resize: str = ""            # "nearest"/"bilinear": resize-convolution engine
+    d2s: bool = False           # conv + depth-to-space rewrite (same cycle count)
+    mm2im: bool = False         # matrix multiplication + col2im engine
+    B: int = 1                  # images interleaved per frame (DECONV_BATCH)
+    NM_N: int = 1               # N:M structured weight sparsity along CI (deconv_nm)
+    NM_M: int = 1
+    TX: int = 1                 # output tile of window positions per weight beat (deconv_tiled)
+    TY: int = 1
+    D: int = 1                  # kernel dilation
+    conv1d: bool = False        # ConvTranspose1d over W samples (deconv1d), H = 1
+
+    def __post_init__(self) -> None:
+        for edge in ("PB", "PL", "PR"):
+            if getattr(self, edge) is None:
+                setattr(self, edge, self.P)
+        if self.conv1d:
+            # A sequence has a left (P) and a right edge only
+            self.H, self.PB, self.PL, self.OPH = 1, self.P, self.P, 0
+
+    # -- Validity (static_asserts of deconv.hpp) ------------------------------
+    def supported(self) -> bool:
+        if self.conv1d:
+            return ((not (self.mm2im or self.resize or self.d2s) and self.D == 1 and self.NM_M == 1
+                     and self.TX * self.TY == 1 and self.P // self.S < self.W)
+                    and (self.CO % self.PE == 0) and (self.CI % self.SIMD == 0))
+        if self.D != 1 and (self.mm2im or self.resize or self.d2s or math.gcd(self.D, self.S) != 1):
+            return False
+        if self.mm2im:
+            return (self.CO % self.PE == 0) and (self.CI % self.SIMD == 0)
+        if self.resize:
+            return ((self.CO % self.PE == 0) and (self.CI % self.SIMD == 0) and self.OPH == self.OPW == 0
+                    and min(self.S * self.H + self.P + self.PB, self.S * self.W + self.PL + self.PR) >= self.K)
+        return ((self.K % self.S == 0) and (self.CO % self.PE == 0) and (self.CI % self.SIMD == 0)
+                and (self.SIMD % self.NM_M == 0))
+
+    # -- Derived template constants -------------------------------------------
+    @property
+    def KK(self) -> int:
+        if self.conv1d:
+            return -(-self.K // self.S)
+        return self.K // self.S
+
+    @property
+    def taps(self) -> int:
+        """Kernel taps per input/output channel pair."""
+        return self.K if self.conv1d else self.K * self.K
+
+    def windows1d(self) -> int:
+        """Window positions of deconv1d_geometry: M1 - M0."""
+        end = (self.W - 1) * self.S + self.K + self.OPW - self.PR
+        return -(-end // self.S) - self.P // self.S
+
+    @property
+    def CF(self) -> int:
+        return self.CO // self.PE
+
+    @property
+    def SF(self) -> int:
+        return self.CI // self.SIMD
+
+    @property
+    def KF(self) -> int:
+        """Outputs spanned by the dilated kernel."""
+        return self.D * (self.K - 1) + 1
+
+    @property
+    def KW(self) -> int:
+        """Input rows/columns spanned by a window of all output phases."""
+        inv = next(r for r in range(self.S) if (self.D * r) % self.S == 1 % self.S)
+        skew = max((self.D * ((s * inv) % self.S) - s) // self.S for s in range(self.S))
+        return self.D * (self.KK - 1) + skew + 1
+
+    def _lead_pad(self, p: int) -> int:
+        a = self.S * (self.KW - 1)
+        return 0 if p >= a else (a - p + self.S - 1) // self.S
+
+    def _lead_crop(self, p: int) -> int:
+        return self.S * self._lead_pad(p) + p - self.S * (self.KW - 1)
+
+    def _trail_pad(self, p: int, op: int) -> int:
+        return 0 if p >= self.KF - self.S + op else (self.KF + op - p - 1) // self.S
+
+    def _trail_crop(self, p: int, op: int) -> int:
+        return self.S * self._trail_pad(p, op) + p - (self.KF - self.S) - op
+
+    @property
+    def PADT(self) -> int:
+        return self._lead_pad(self.P)
+
+    @property
+    def PADB(self) -> int:
+        return self._trail_pad(self.PB, self.OPH)
+
+    @property
+    def PADL(self) -> int:
+        return self._lead_pad(self.PL)
+
+    @property
+    def PADR(self) -> int:
+        return self._trail_pad(self.PR, self.OPW)
+
+    @property
+    def H_EFF(self) -> int:
+        return self.PADT + self.H + self.PADB
+
+    @property
+    def W_EFF(self) -> int:
+        return self.PADL + self.W + self.PADR
+
+    @property
+    def HO_EFF(self) -> int:
+        return (self.H_EFF - self.KW + 1) * self.S
+
+    @property
+    def WO_EFF(self) -> int:
+        return (self.W_EFF - self.KW + 1) * self.S
+
+    @property
+    def HO(self) -> int:
+        if self.conv1d:
+            return 1
+        if self.mm2im:
+            return (self.H - 1) * self.S + self.K - self.P - self.PB + self.OPH
+        if self.resize:
+            return self.S * self.H + self.P + self.PB - self.K + 1
+        return self.HO_EFF - self._lead_crop(self.P) - self._trail_crop(self.PB, self.OPH)
+
+    @property
+    def WO(self) -> int:
+        if self.mm2im or self.conv1d:
+            return (self.W - 1) * self.S + self.K - self.PL - self.PR + self.OPW
+        if self.resize:
+            return self.S * self.W + self.PL + self.PR - self.K + 1
+        return self.WO_EFF - self._lead_crop(self.PL) - self._trail_crop(self.PR, self.OPW)
+
+    # -- Stream beat counts per frame -----------------------------------------
+    def input_beats(self) -> int:
+        """Beats consumed from `src` (SIMD lanes each)."""
+        return self.H * self.W * self.SF * self.B
+
+    def resized_beats(self) -> int:
+        """Beats emitted by the upsampling stages of the resize-convolution engine."""
+        return self.S * self.S * self.H * self.W * self.SF * self.B if self.resize else 0
+
+    def col2im_beats(self) -> int:
+        """Beats drained by `col2im`: the uncropped output incl. output padding."""
+        if not self.mm2im:
+            return 0
+        hf = (self.H - 1) * self.S + self.K + self.OPH
+        wf = (self.W - 1) * self.S + self.K + self.OPW
+        return hf * wf * self.CF * self.B
+
+    @property
+    def tiled(self) -> bool:
+        return not (self.mm2im or self.resize or self.conv1d) and self.TX * self.TY > 1
+
+    def tiles(self) -> int:
+        """Tile positions per frame: window positions in TX x TY blocks."""
+        rows = -(-(self.H_EFF - self.KW + 1) // self.TY)
+        cols = -(-(self.W_EFF - self.KW + 1) // self.TX)
+        return rows * cols
+
+    def weight_beats(self) -> int:
+        """Beats emitted by `deconv_weights`, each applied to B windows (B*TX*TY when tiled)."""
+        if self.mm2im:
+            return self.H * self.W * self.CF * self.K * self.K * self.SF
+        if self.resize:
+            return self.HO * self.WO * self.CF * self.K * self.K * self.SF
+        if self.conv1d:
+            return self.windows1d() * self.S * self.CF * self.KK * self.SF
+        if self.tiled:
+            return self.tiles() * self.S * self.S * self.CF * self.KK * self.KK * self.SF
+        return self.HO_EFF * self.WO_EFF * self.CF * self.KK * self.KK * self.SF
+
+    def window_beats(self) -> int:
+        """Beats emitted by `deconv_swg`, one MVU cycle each."""
+        if self.tiled:
+            return self.weight_beats() * self.B * self.TX * self.TY
+        return self.weight_beats() * self.B
+
+    def output_beats(self) -> int:
+        """Beats written to `dst` after cropping (PE lanes each)."""
+        return self.HO * self.WO * self.CF * self.B
+
+    def macs(self) -> int:
+        """Useful multiply-accumulates per frame (PE*SIMD*N/M per MVU beat, tile extensions excluded)."""
+        beats = self.window_beats()
+        if self.tiled:
+            beats = self.HO_EFF * self.WO_EFF * self.CF * self.KK * self.KK * self.SF * self.B
+        return beats * self.PE * self.SIMD * self.NM_N // self.NM_M
+
+    # -- Throughput -----------------------------------------------------------
+    def cycles_per_frame(self) -> int:
+        """Steady-state initiation interval of one frame in clock cycles."""
+        return max(self.input_beats(), self.resized_beats(), self.window_beats(), self.col2im_beats(),
+                   self.output_beats())
+
+    def beats_per_cycle(self) -> float:
+        return self.output_beats() / self.cycles_per_frame()
+
+    def frames_per_second(self, fmax_mhz: float) -> float:
+        """Images (not batches) per second."""
+        return self.B * fmax_mhz * 1e6 / self.cycles_per_frame()
+
+    def summary(self) -> Dict[str, float]:
+        return {
+            "input_beats": self.input_beats(),
+            "window_beats": self.window_beats(),
+            "weight_beats": self.weight_beats(),
+            "output_beats": self.output_beats(),
+            "cycles_per_frame": self.cycles_per_frame(),
+            "beats_per_cycle": self.beats_per_cycle(),
+            "macs": self.macs(),
+        }
+
+
+def design_from_names(project_name: str, solution_name: str = "") -> Optional[DeconvDesign]:
+    """Reconstruct a design from HLS project and solution directory names."""
+    m = PROJECT_RE.search(project_name)
+    if not m:
+        return None
+    K, S, H, W, CI, CO, P = (int(g) for g in m.groups()[:7])
+    design = DeconvDesign(K, S, H, W, CI, CO, P)
+    for tag, value, group in EDGE_RE.findall(m.group(8) or ""):
+        if tag in ("PB", "PL", "PR"):
+            setattr(design, tag, int(value))
+        elif tag == "OP":
+            design.OPH = design.OPW = int(value)
+        elif tag == "D":
+            design.D = int(value)
+        elif tag in RESIZE_TAGS:
+            design.resize = RESIZE_TAGS[tag]
+        elif tag == "PS":
+            design.d2s = True
+        elif tag == "MM":
+            design.mm2im = True
+        elif tag == "DIM" and value == "1":
+            design.conv1d = True
+        elif tag == "NM" and group:
+            design.NM_N, design.NM_M = int(value), int(group)
+    s = SOLUTION_RE.search(solution_name)
+    if s:
+        design.PE = int(s.group(2))
+        design.SIMD = int(s.group(3))
+    return design
+
+
+def clock_from_solution(solution_name: str) -> Optional[float]:
+    """Target clock period (ns) encoded in a solution name, e.g. `_CLK3p3`."""
+    s = SOLUTION_RE.search(solution_name)
+    if s and s.group(4):
+        return float(s.group(4).replace("p", "."))
+    return None
+
+
+def main(argv) -> int:
+    p = argparse.ArgumentParser(description="Analytical cycle model of the deconv pipeline.")
+    for name in ("K", "S", "H", "W", "CI", "CO", "P"):
+        p.add_argument(f"--{name}", type=int, required=True)
+    p.add_argument("--PE", type=int, default=1)
+    p.add_argument("--SIMD", type=int, default=1)
+    p.add_argument("--PB", type=int, help="Bottom padding (default: P)")
+    p.add_argument("--PL", type=int, help="Left padding (default: P)")
+    p.add_argument("--PR", type=int, help="Right padding (default: P)")
+    p.add_argument("--OP", type=int, default=0, help="Output padding, bottom/right (default: 0)")
+    p.add_argument("--D", type=int, default=1, help="Kernel dilation, coprime to S (default: 1)")
+    p.add_argument("--resize", choices=["nearest", "bilinear"],
+                   help="Model the resize-convolution engine (upsample by S, stride-1 conv) instead")
+    p.add_argument("--mm2im", action="store_true", help="Model the MM2IM engine instead")
+    p.add_argument("--conv1d", action="store_true",
+                   help="Model deconv1d(): ConvTranspose1d over W samples, H is ignored, P/PR left/right padding")
+    p.add_argument("--nm", help="N:M structured weight sparsity along CI, e.g. 2:4 (default: dense)")
+    p.add_argument("--batch", type=int, default=1, help="Images interleaved per frame (default: 1)")
+    p.add_argument("--tile", default="1x1", help="Output tile TXxTY of deconv_tiled() (default: 1x1)")
+    p.add_argument("--fmax", type=float, default=200.0, help="Clock frequency in MHz (default: 200)")
+    args = p.parse_args(argv)
+    nm_n, nm_m = (int(v) for v in args.nm.split(":")) if args.nm else (1, 1)
+    tx, _, ty = args.tile.lower().partition("x")
+
+    d = DeconvDesign(args.K, args.S, args.H, args.W, args.CI, args.CO, args.P, args.PE, args.SIMD,
+                     PB=args.PB, PL=args.PL, PR=args.PR, OPH=args.OP, OPW=args.OP,
+                     resize=args.resize or "", mm2im=args.mm2im, B=args.batch, NM_N=nm_n, NM_M=nm_m,
+                     TX=int(tx), TY=int(ty or 1), D=args.D, conv1d=args.conv1d)
+    if not d.supported():
+        print(f"Unsupported configuration: {d}")
+        return 1
+    for k, v in d.summary().items():
+        print(f"{k:<18} {v}")
+    print(f"{'frames_per_second':<18} {d.frames_per_second(args.fmax):.1f} @ {args.fmax} MHz")
+    if d.conv1d:
+        print(f"{'samples_per_second':<18} {d.frames_per_second(args.fmax) * d.WO:.1f} output samples")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""
+Roofline / System Model for the Streaming Deconvolution Pipeline
+================================================================
+
+Combines the cycle model of `deconv_model.py` with a configurable memory
+system to estimate the frame rate a layer actually attains once its input,
+output and weights have to move between DDR and the accelerator:
+
+  compute   cycles_per_frame / fmax
+  input     input tensor bytes    / DMA channel bandwidth
+  output    output tensor bytes   / DMA channel bandwidth
+  weight    weight bytes          / DMA channel bandwidth
+  ddr       all bytes             / (DDR bandwidth x efficiency)
+
+Each of input, output and weights has its own DMA channel, and all three
+share the DDR bandwidth. The slowest term bounds the frame rate. A layer is
+classified by that term. When the shared DDR bound wins, the layer is
+classified by its largest traffic class. Weight traffic depends on where
+the kernel lives:
+
+  onchip    KERNEL ROM in the generated header (no traffic, the default)
+  frame     kernel loaded from DDR once per frame
+  stream    every `deconv_weights` beat fetched from DDR, i.e. the weight
+            sequence is re-read for every window; batching (--batch, see
+            DECONV_BATCH) divides it by the batch size, output-tile
+            blocking (--tile, see DECONV_TILE_X/_Y) by the tile size
+
+Output traffic is scaled by --out-ratio, the encoded/raw beat ratio of an
+output encoder (DECONV_ENCODE), e.g. `dst_ratio` from the host benchmark.
+
+Usage:
+  python deconv_roofline.py                                  # deconv_configs.csv sweep
+  python deconv_roofline.py --weights stream --ddr-gbps 12.8 --pe-simd 1x1,4x1
+  python deconv_roofline.py --K 4 --S 2 --H 32 --W 32 --CI 64 --CO 32 --P 1 --pe-simd 8x8
+"""
+from __future__ import annotations
+
+import argparse
+import csv
+import math
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from deconv_model import DeconvDesign
+
+BOUNDS = ("compute", "input", "output", "weight")
+HINTS = {
+    "compute": "raise PE/SIMD or Fmax",
+    "input": "pack/narrow activations or widen the input DMA",
+    "output": "narrow TO, encode the output or widen the output DMA",
+    "weight": "keep weights on chip or batch frames (DECONV_BATCH)",
+}
+
+
+@dataclass
+class MemorySystem:
+    fmax_mhz: float = 200.0
+    ddr_gbps: float = 19.2          # peak DDR bandwidth, GB/s
+    ddr_efficiency: float = 0.7     # sustained fraction of the peak
+    dma_gbps: float = 3.2           # per DMA channel (input / output / weights)
+    in_bits: int = 4                # TI
+    out_bits: int = 16              # TO
+    weight_bits: int = 8            # TW
+    weights: str = "onchip"         # onchip | frame | stream
+    out_ratio: float = 1.0          # encoded / raw output beats (DECONV_ENCODE)
+
+
+@dataclass
+class Roofline:
+    design: DeconvDesign
+    mem: MemorySystem
+
+    # -- Traffic per frame (bytes, B images) ----------------------------------
+    def input_bytes(self) -> float:
+        return self.design.input_beats() * self.design.SIMD * self.mem.in_bits / 8
+
+    def output_bytes(self) -> float:
+        return self.design.output_beats() * self.design.PE * self.mem.out_bits / 8 * self.mem.out_ratio
+
+    def weight_bytes(self) -> float:
+        d = self.design
+        # N:M sparse weights carry N of every M values, each with its lane position
+        bits = (self.mem.weight_bits + (d.NM_M - 1).bit_length()) * d.NM_N / d.NM_M
+        if self.mem.weights == "stream":
+            return d.weight_beats() * d.PE * d.SIMD * bits / 8
+        if self.mem.weights == "frame":
+            return d.CI * d.CO * d.taps * bits / 8
+        return 0.0
+
+    # -- Time per frame (seconds) ---------------------------------------------
+    def times(self) -> Dict[str, float]:
+        dma = self.mem.dma_gbps * 1e9
+        return {
+            "compute": self.design.cycles_per_frame() / (self.mem.fmax_mhz * 1e6),
+            "input": self.input_bytes() / dma,
+            "output": self.output_bytes() / dma,
+            "weight": self.weight_bytes() / dma,
+            "ddr": self.total_bytes() / (self.mem.ddr_gbps * 1e9 * self.mem.ddr_efficiency),
+        }
+
+    def total_bytes(self) -> float:
+        return self.input_bytes() + self.output_bytes() + self.weight_bytes()
+
+    def bound(self) -> Tuple[str, bool]:
+        """Binding term and whether it is the shared DDR bandwidth."""
+        t = self.times()
+        worst = max(t, key=t.get)
+        if worst != "ddr":
+            return worst, False
+        traffic = {"input": self.input_bytes(), "output": self.output_bytes(),
+                   "weight": self.weight_bytes()}
+        return max(traffic, key=traffic.get), True
+
+    def attainable_fps(self) -> float:
+        """Images per second."""
+        return self.design.B / max(self.times().values())
+
+    def compute_fps(self) -> float:
+        return self.design.frames_per_second(self.mem.fmax_mhz)
+
+    def intensity(self) -> float:
+        """Arithmetic intensity in MACs per DDR byte."""
+        total = self.total_bytes()
+        return self.design.macs() / total if total else math.inf
+
+    def row(self) -> Dict:
+        d = self.design
+        bound, via_ddr = self.bound()
+        t = self.times()
+        return {
+            "K": d.K, "S": d.S, "H": d.H, "W": d.W, "CI": d.CI, "CO": d.CO, "P": d.P,
+            "PE": d.PE, "SIMD": d.SIMD, "B": d.B,
+            "cycles_per_frame": d.cycles_per_frame(),
+            "input_kB": round(self.input_bytes() / 1e3, 3),
+            "output_kB": round(self.output_bytes() / 1e3, 3),
+            "weight_kB": round(self.weight_bytes() / 1e3, 3),
+            "macs_per_byte": round(self.intensity(), 2),
+            "compute_fps": round(self.compute_fps(), 1),
+            "attainable_fps": round(self.attainable_fps(), 1),
+            "efficiency": round(self.attainable_fps() / self.compute_fps(), 3),
+            "bound": bound + ("/ddr" if via_ddr else ""),
+            "ddr_share": round(t["ddr"] / max(t.values()), 3),
+            "hint": "" if bound == "compute" else HINTS[bound],
+        }
+
+
+def parse_pe_simd(text: str) -> List[Tuple[int, int]]:
+    pairs = []
+    for item in text.split(","):
+        pe, _, simd = item.strip().lower().partition("x")
+        pairs.append((int(pe), int(simd or 1)))
+    return pairs
+
+
+def designs_from_csv(path: Path) -> List[DeconvDesign]:
+    """Layers of a benchmark config table (generate_deconv_configs.py format)."""
+    def opt(row: Dict, key: str) -> Optional[int]:
+        value = row.get(key)
+        return int(value) if value not in (None, "") else None
+
+    designs = []
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            size = int(row["input_size"])
+            op = opt(row, "output_padding") or 0
+            designs.append(DeconvDesign(
+                int(row["kernel_size"]), int(row["stride"]), size, size,
+                int(row["in_channels"]), int(row["out_channels"]), int(row["padding"]),
+                PB=opt(row, "padding_bottom"), PL=opt(row, "padding_left"),
+                PR=opt(row, "padding_right"), OPH=op, OPW=op, resize=row.get("resize") or "",
+                D=opt(row, "dilation") or 1, conv1d=opt(row, "dims") == 1))
+            if row.get("sparsity"):
+                designs[-1].NM_N, designs[-1].NM_M = (int(v) for v in row["sparsity"].split(":"))
+    return designs
+
+
+def main(argv) -> int:
+    base_dir = Path(__file__).resolve().parent.parent
+    p = argparse.ArgumentParser(description="Roofline model of deconv layers incl. DMA/DDR bandwidth.")
+    p.add_argument("--configs", type=Path, default=base_dir / "deconv_data" / "configs" / "deconv_configs.csv",
+                   help="Benchmark config CSV (ignored when a single layer is given with --K ...)")
+    for name in ("K", "S", "H", "W", "CI", "CO", "P"):
+        p.add_argument(f"--{name}", type=int)
+    p.add_argument("--pe-simd", default="1x1", help="Comma-separated PExSIMD points, e.g. 1x1,4x2 (default: 1x1)")
+    p.add_argument("--batch", type=int, default=1, help="Images interleaved per frame (default: 1)")
+    p.add_argument("--tile", default="1x1", help="Output tile TXxTY per weight beat (default: 1x1)")
+    p.add_argument("--fmax", type=float, default=200.0, help="Clock frequency in MHz (default: 200)")
+    p.add_argument("--ddr-gbps", type=float, default=19.2, help="Peak DDR bandwidth in GB/s (default: 19.2)")
+    p.add_argument("--ddr-efficiency", type=float, default=0.7, help="Sustained DDR fraction (default: 0.7)")
+    p.add_argument("--dma-gbps", type=float, default=3.2, help="Bandwidth per DMA channel in GB/s (default: 3.2)")
+    p.add_argument("--in-bits", type=int, default=4, help="Activation width TI (default: 4)")
+    p.add_argument("--out-bits", type=int, default=16, help="Output width TO (default: 16)")
+    p.add_argument("--weight-bits", type=int, default=8, help="Weight width TW (default: 8)")
+    p.add_argument("--weights", choices=["onchip", "frame", "stream"], default="onchip",
+                   help="Where weights come from (default: onchip)")
+    p.add_argument("--out-ratio", type=float, default=1.0,
+                   help="Encoded/raw output beats with DECONV_ENCODE, e.g. host-bench dst_ratio (default: 1.0)")
+    p.add_argument("--csv", type=Path, help="Also write the table to this CSV file")
+    args = p.parse_args(argv)
+
+    layer = [getattr(args, n) for n in ("K", "S", "H", "W", "CI", "CO", "P")]
+    if all(v is not None for v in layer):
+        layers = [DeconvDesign(*layer)]
+    elif any(v is not None for v in layer):
+        p.error("a single layer needs all of --K --S --H --W --CI --CO --P")
+    else:
+        if not args.configs.exists():
+            p.error(f"config CSV not found: {args.configs}")
+        layers = designs_from_csv(args.configs)
+
+    tx, _, ty = args.tile.lower().partition("x")
+    tile = (int(tx), int(ty or 1))
+    mem = MemorySystem(args.fmax, args.ddr_gbps, args.ddr_efficiency, args.dma_gbps,
+                       args.in_bits, args.out_bits, args.weight_bits, args.weights, args.out_ratio)
+    rows = []
+    for layer in layers:
+        for pe, simd in parse_pe_simd(args.pe_simd):
+            d = DeconvDesign(**{**layer.__dict__, "PE": pe, "SIMD": simd, "B": args.batch,
+                                "TX": tile[0], "TY": tile[1]})
+            if d.supported():
+                rows.append(Roofline(d, mem).row())
+    if not rows:
+        print("No supported layer / PE x SIMD combination")
+        return 1
+
+    ridge = mem.ddr_gbps * mem.ddr_efficiency * 1e9 / (mem.fmax_mhz * 1e6)
+    print(f"Memory system: DDR {mem.ddr_gbps} GB/s x {mem.ddr_efficiency}, DMA {mem.dma_gbps} GB/s/channel, "
+          f"weights {mem.weights}, {mem.fmax_mhz} MHz (DDR bytes/cycle {ridge:.1f})")
+    cols = ["K", "S", "H", "CI", "CO", "P", "PE", "SIMD", "B", "macs_per_byte",
+            "compute_fps", "attainable_fps", "efficiency", "bound"]
+    width = {c: max(len(c), 4) for c in cols}
+    print(" ".join(f"{c:>{width[c]}}" for c in cols))
+    for r in rows:
+        print(" ".join(f"{str(r[c]):>{width[c]}}" for c in cols))
+    summary = {b: sum(1 for r in rows if r["bound"].split("/")[0] == b) for b in BOUNDS}
+    print("Layers by bound: " + ", ".join(f"{b}={n}" for b, n in summary.items()))
+    for b in BOUNDS[1:]:
+        if summary[b]:
+            print(f"  {b}-bound: {HINTS[b]}")
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0]))
+            writer.writeheader()
+            writer.writerows(rows)
+        print(f"Wrote {args.csv}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
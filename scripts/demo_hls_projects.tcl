@@ -25,8 +25,8 @@ proc log_error {message} {
 }
 
 proc parse_config_filename {filename} {
-    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)\.hpp} $filename match K S H W CI CO P]} {
-        return [list $K $S $H $W $CI $CO $P]
+    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)((?:_[A-Z]+\d+)*)\.hpp} $filename match K S H W CI CO P EDGES]} {
+        return [list $K $S $H $W $CI $CO $P $EDGES]
     } else {
         return {}
     }
@@ -93,7 +93,7 @@ proc create_demo_project {project_name config_params pe_simd_configs config_file
     log_info "  Copied configuration header"
     
     # Copy source files
-    set source_files {deconv_top.cpp deconv.hpp utils.hpp deconv_tb.cpp}
+    set source_files {deconv_top.cpp deconv_top_frame.hpp deconv_maxi_top.cpp deconv_maxi_top.hpp deconv.hpp resize_conv.hpp mm2im.hpp deconv1d.hpp output_codec.hpp utils.hpp deconv_tb.cpp}
     foreach src_file $source_files {
         set src_path "${SRC_DIR}/${src_file}"
         if {[file exists $src_path]} {
@@ -179,15 +179,15 @@ proc main {} {
         log_info "Processing: $filename"
         
         set config_params [parse_config_filename $filename]
-        if {[llength $config_params] != 7} {
+        if {[llength $config_params] != 8} {
             log_error "Could not parse: $filename"
             continue
         }
         
         set pe_simd_configs [extract_pe_simd_configs $config_file]
         
-        lassign $config_params K S H W CI CO P
-        set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}"
+        lassign $config_params K S H W CI CO P EDGES
+        set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}${EDGES}"
         
         if {[create_demo_project $project_name $config_params $pe_simd_configs $config_file]} {
             incr successful_projects
@@ -12,23 +12,94 @@ Usage:
 """
 
 import argparse
+import copy
 import csv
+import math
 import sys
 from pathlib import Path
 from typing import List, Tuple, Dict
 
 
+# Resize-convolution engines (upsample by S, then stride-1 convolution):
+# name tag and RESIZE constant of src/resize_conv.hpp
+RESIZE_MODES = {
+    'nearest': ('NN', 1),
+    'bilinear': ('BL', 2),
+}
+
+
 class DeconvConfig:
     """Configuration class for deconvolution parameters"""
     
-    def __init__(self, K: int, S: int, H: int, W: int, CI: int, CO: int, P: int = None):
+    def __init__(self, K: int, S: int, H: int, W: int, CI: int, CO: int, P: int = None,
+                 PB: int = None, PL: int = None, PR: int = None, OP: int = 0, D: int = 1,
+                 resize: str = "", d2s: bool = False, mm2im: bool = False, sparsity: str = "", dims: int = 2):
         self.K = K      # Kernel size
         self.S = S      # Stride
         self.H = H      # Input height
         self.W = W      # Input width
         self.CI = CI    # Input channels
         self.CO = CO    # Output channels
-        self.P = P if P is not None else K - S  # Padding (derived if not provided)
+        self.P = P if P is not None else K - S  # Padding (derived if not provided), top edge
+        self.PB = PB if PB is not None else self.P  # Bottom padding
+        self.PL = PL if PL is not None else self.P  # Left padding
+        self.PR = PR if PR is not None else self.P  # Right padding
+        self.OP = OP    # Output padding (bottom/right)
+        self.D = D      # Dilation
+        self.resize = resize or ""  # '' (transposed conv), 'nearest' or 'bilinear'
+        self.d2s = d2s  # Conv + depth-to-space rewrite of the transposed conv
+        self.mm2im = mm2im  # Matrix multiplication + col2im engine for the same layer
+        self.sparsity = sparsity or ""  # '' (dense) or 'N:M' structured sparsity along CI
+        self.dims = dims  # 2: ConvTranspose2d, 1: ConvTranspose1d over W samples (H = 1, P left, PR right)
+
+    @property
+    def nm(self) -> Tuple[int, int]:
+        """(N, M) of the structured sparsity, (1, 1) for dense layers."""
+        if not self.sparsity:
+            return 1, 1
+        n, m = (int(v) for v in self.sparsity.split(':'))
+        return n, m
+
+    @property
+    def symmetric(self) -> bool:
+        return self.P == self.PB == self.PL == self.PR
+
+    def padding_suffix(self) -> str:
+        """Name suffix for non-default edges, dilation, resize engines and sparsity, e.g. _PB1_PL0_PR1_OP1, _D2, _BL2 or _NM2of4."""
+        suffix = ""
+        if not self.symmetric:
+            suffix += f"_PB{self.PB}_PL{self.PL}_PR{self.PR}"
+        if self.OP:
+            suffix += f"_OP{self.OP}"
+        if self.D != 1:
+            suffix += f"_D{self.D}"
+        if self.resize:
+            suffix += f"_{RESIZE_MODES[self.resize][0]}{self.S}"
+        if self.sparsity:
+            n, m = self.nm
+            suffix += f"_NM{n}of{m}"
+        return suffix
+
+    def tag(self) -> str:
+        # The depth-to-space rewrite and MM2IM compute the same layer: they share the benchmark data
+        engine = f"_PS{self.S}" if self.d2s else f"_MM{self.S}" if self.mm2im else ""
+        if self.dims == 1:
+            engine += "_DIM1"
+        return f"K{self.K}_S{self.S}_H{self.H}_W{self.W}_CI{self.CI}_CO{self.CO}_P{self.P}{self.padding_suffix()}{engine}"
+
+    def supports_d2s(self) -> bool:
+        """The conv + depth-to-space rewrite applies to strided transposed convolutions with S | K."""
+        return (self.dims == 2 and not self.resize and not self.sparsity and self.D == 1 and self.S > 1
+                and self.K % self.S == 0)
+
+    def supports_mm2im(self) -> bool:
+        """MM2IM computes any dense undilated 2D transposed convolution, but not the resize engines."""
+        return self.dims == 2 and not self.resize and not self.sparsity and self.D == 1
+
+    def data_basename(self) -> str:
+        """Base name of the benchmark tensors written by deconv_benchmark.py."""
+        return (f"deconv_{self.W}x{self.H}_in{self.CI}_out{self.CO}_k{self.K}_s{self.S}_p{self.P}"
+                f"{self.padding_suffix().lower()}")
     
     def validate(self) -> bool:
         """Validate parameter constraints"""
@@ -36,12 +107,46 @@ class DeconvConfig:
             return False
         if self.CI <= 0 or self.CO <= 0:
             return False
-        if self.P < 0:
+        if min(self.P, self.PB, self.PL, self.PR, self.OP) < 0:
+            return False
+        if self.resize and (self.resize not in RESIZE_MODES or self.OP):
+            return False
+        if self.D != 1:
+            # Dilated windows of deconv_swg(), see deconv_dilation in src/deconv.hpp
+            if self.resize or self.D < 1 or math.gcd(self.D, self.S) != 1 or self.K % self.S:
+                return False
+        if self.dims == 1:
+            # deconv1d() in src/deconv1d.hpp: left (P) and right edges only, any K and S
+            if self.H != 1 or self.PB != self.P or self.PL != self.P or self.resize or self.sparsity or self.D != 1:
+                return False
+        elif self.dims != 2:
             return False
+        if self.sparsity:
+            # deconv_nm() builds on the S | K decomposition of deconv_asym()
+            n, m = self.nm
+            if self.resize or not 0 < n < m or self.CI % m or self.K % self.S:
+                return False
         return True
     
     def __str__(self):
-        return f"K={self.K}, S={self.S}, H={self.H}, W={self.W}, CI={self.CI}, CO={self.CO}, P={self.P}"
+        text = f"K={self.K}, S={self.S}, H={self.H}, W={self.W}, CI={self.CI}, CO={self.CO}, P={self.P}"
+        if not self.symmetric:
+            text += f", PB={self.PB}, PL={self.PL}, PR={self.PR}"
+        if self.OP:
+            text += f", OP={self.OP}"
+        if self.D != 1:
+            text += f", D={self.D}"
+        if self.resize:
+            text += f", resize={self.resize}"
+        if self.d2s:
+            text += ", conv+depth-to-space"
+        if self.mm2im:
+            text += ", mm2im"
+        if self.sparsity:
+            text += f", sparsity={self.sparsity}"
+        if self.dims == 1:
+            text += ", 1D"
+        return text
 
 
 def load_weights_from_csv(weights_path: str) -> List[int]:
@@ -67,13 +172,97 @@ def load_weights_from_csv(weights_path: str) -> List[int]:
     return values
 
 
+def native_weights(config: DeconvConfig, pe: int, simd: int, weights: List[int]) -> List[int]:
+    """Reorder PyTorch weights into the native KERNEL order.
+
+    The native order is [CO/PE][K][K][CI/SIMD][PE][SIMD] with output channel
+    c*PE+p and input channel d*SIMD+s. Transposed convolutions come as
+    ConvTranspose2d weights (CI, CO, K, K), the resize engines as the Conv2d
+    weights (CO, CI, K, K) of their stride-1 convolution. ConvTranspose1d
+    weights (CI, CO, K) map to [CO/PE][K][CI/SIMD][PE][SIMD] alike.
+    """
+    K, CI, CO = config.K, config.CI, config.CO
+    reordered = []
+    if config.dims == 1:
+        for c in range(CO // pe):
+            for k in range(K):
+                for d in range(CI // simd):
+                    for p in range(pe):
+                        for s in range(simd):
+                            reordered.append(weights[((d * simd + s) * CO + c * pe + p) * K + k])
+        return reordered
+
+    def source(co: int, ci: int, kh: int, kw: int) -> int:
+        if config.resize:
+            return ((co * CI + ci) * K + kh) * K + kw
+        return ((ci * CO + co) * K + kh) * K + kw
+
+    for c in range(CO // pe):
+        for kh in range(K):
+            for kw in range(K):
+                for d in range(CI // simd):
+                    for p in range(pe):
+                        for s in range(simd):
+                            reordered.append(weights[source(c * pe + p, d * simd + s, kh, kw)])
+    return reordered
+
+
+def sparse_weights(config: DeconvConfig, pe: int, simd: int, weights: List[int]) -> Tuple[List[int], List[int]]:
+    """Compress native N:M sparse weights into the values and lane positions of deconv_nm().
+
+    Every group of M SIMD lanes keeps N weights together with their position
+    within the group. Groups with fewer nonzeros are padded with zero weights
+    at unused positions.
+    """
+    n, m = config.nm
+    values, positions = [], []
+    for base in range(0, len(weights), m):
+        group = weights[base:base + m]
+        keep = [j for j in range(m) if group[j]]
+        if len(keep) > n:
+            raise ValueError(f"Weights of {config} are not {n}:{m} sparse")
+        keep += [j for j in range(m) if not group[j]][:n - len(keep)]
+        values.extend(group[j] for j in keep)
+        positions.extend(keep)
+    return values, positions
+
+
+def depth_to_space_weights(config: DeconvConfig, pe: int, simd: int, weights: List[int]) -> List[int]:
+    """Rearrange a transposed conv kernel for the conv + depth-to-space rewrite.
+
+    `weights` is in the native KERNEL order [CO/PE][K][K][CI/SIMD][PE][SIMD].
+    The result feeds deconv_d2s() in src/deconv.hpp, a stride-1 convolution
+    with a (K/S)x(K/S) kernel over S*S*CO channels ordered by their position
+    (sh, sw) within the SxS output block:
+      [S][S][CO/PE][K/S][K/S][CI/SIMD][PE][SIMD],
+      (sh, sw, c, i, j) <- (c, S*(K/S-1-i)+sh, S*(K/S-1-j)+sw)
+    """
+    K, S, KK = config.K, config.S, config.K // config.S
+    CF, SF = config.CO // pe, config.CI // simd
+    lane = pe * simd
+
+    def native(c: int, kh: int, kw: int, d: int) -> int:
+        return (((c * K + kh) * K + kw) * SF + d) * lane
+
+    rearranged = []
+    for sh in range(S):
+        for sw in range(S):
+            for c in range(CF):
+                for i in range(KK):
+                    for j in range(KK):
+                        for d in range(SF):
+                            base = native(c, S * (KK - 1 - i) + sh, S * (KK - 1 - j) + sw, d)
+                            rearranged.extend(weights[base:base + lane])
+    return rearranged
+
+
 def generate_kernel_weights(config: DeconvConfig, pe: int = 1, simd: int = 1, 
                             weights: List[int] = None) -> str:
     """Generate kernel weight array in C++ format.
     
     If weights is provided, use it; otherwise generate a simple incremental pattern.
     """
-    outer_dim = (config.CO // pe) * config.K * config.K * (config.CI // simd)
+    outer_dim = (config.CO // pe) * config.K ** config.dims * (config.CI // simd)
     total_elems = outer_dim * pe * simd
     
     if weights is None or len(weights) == 0:
@@ -85,32 +274,41 @@ def generate_kernel_weights(config: DeconvConfig, pe: int = 1, simd: int = 1,
             weights = weights + [0] * (total_elems - len(weights))
         elif len(weights) > total_elems:
             weights = weights[:total_elems]
+        weights = native_weights(config, pe, simd, weights)
+    if config.d2s:
+        # Same element count: S*S*(CO/PE)*(K/S)^2*(CI/SIMD) == (CO/PE)*K*K*(CI/SIMD)
+        weights = depth_to_space_weights(config, pe, simd, weights)
     
+    if not config.sparsity:
+        return format_kernel("static TW const  KERNEL", outer_dim, pe, simd, [f"0x{(w & 0xFF):02x}" for w in weights])
+
+    n, m = config.nm
+    values, positions = sparse_weights(config, pe, simd, weights)
+    lanes = simd * n // m
+    pos_bits = max(1, (m - 1).bit_length())
+    return "\n".join([
+        format_kernel("static TW const  KERNEL", outer_dim, pe, lanes, [f"0x{(w & 0xFF):02x}" for w in values]),
+        format_kernel(f"static ap_uint<{pos_bits}> const  KERNEL_POS", outer_dim, pe, lanes, [str(j) for j in positions]),
+    ])
+
+
+def format_kernel(decl: str, outer_dim: int, pe: int, lanes: int, values: List[str]) -> str:
+    """Format flat element strings as a C++ [outer_dim][pe][lanes] initializer."""
     kernel_lines = []
-    kernel_lines.append(f"static TW const  KERNEL[{outer_dim}][{pe}][{simd}] = {{")
+    kernel_lines.append(f"{decl}[{outer_dim}][{pe}][{lanes}] = {{")
     
     idx = 0
-    for _co_group in range(config.CO // pe):
-        for _k_row in range(config.K):
-            for _k_col in range(config.K):
-                for _ci_group in range(config.CI // simd):
-                    pe_values = []
-                    for _p in range(pe):
-                        simd_values = []
-                        for _s in range(simd):
-                            hex_val = f"0x{(weights[idx] & 0xFF):02x}"
-                            simd_values.append(hex_val)
-                            idx += 1
-                        if simd == 1:
-                            pe_values.append(f"{{{simd_values[0]},}}")
-                        else:
-                            pe_values.append(f"{{{','.join(simd_values)},}}")
-                    
-                    if pe == 1:
-                        line = f"\t{{{pe_values[0]}}},"
-                    else:
-                        line = f"\t{{{','.join(pe_values)}}},"
-                    kernel_lines.append(line)
+    for _outer in range(outer_dim):
+        pe_values = []
+        for _p in range(pe):
+            pe_values.append(f"{{{','.join(values[idx:idx + lanes])},}}")
+            idx += lanes
+        
+        if pe == 1:
+            line = f"\t{{{pe_values[0]}}},"
+        else:
+            line = f"\t{{{','.join(pe_values)}}},"
+        kernel_lines.append(line)
     
     kernel_lines.append("};")
     return "\n".join(kernel_lines)
@@ -123,8 +321,9 @@ def generate_pe_simd_configs(config: DeconvConfig) -> List[Tuple[int, int]]:
     # Find divisors of CO for PE
     pe_options = [i for i in range(1, config.CO + 1) if config.CO % i == 0]
     
-    # Find divisors of CI for SIMD
-    simd_options = [i for i in range(1, config.CI + 1) if config.CI % i == 0]
+    # Find divisors of CI for SIMD, whole groups of M lanes for N:M sparse layers
+    m = config.nm[1]
+    simd_options = [i for i in range(m, config.CI + 1, m) if config.CI % i == 0]
     
     # Common configurations
     for pe in pe_options[:3]:  # Limit to first 3 options
@@ -141,6 +340,26 @@ def generate_header_file(config: DeconvConfig, pe_simd_configs: List[Tuple[int,
     If weights_path is provided, load weights from CSV and pass them 
     to generate_kernel_weights.
     """
+    engine_decl = ""
+    out_bits = 16
+    if config.d2s:
+        engine_decl = "#define DECONV_DEPTH_TO_SPACE\t\t// stride-1 conv to S*S*CO channels, then depth-to-space\n\n"
+    if config.mm2im:
+        engine_decl = "#define DECONV_MM2IM\t\t\t\t// per-pixel matrix multiplication, then col2im overlap-add\n\n"
+    if config.sparsity:
+        n, m = config.nm
+        engine_decl = (f"#define DECONV_NM_SPARSE\t\t\t// {n}:{m} structured sparsity along CI\n"
+                       f"constexpr unsigned  NM_N = {n};\t\t// nonzero weights\n"
+                       f"constexpr unsigned  NM_M = {m};\t\t// per group of input channels\n\n")
+    if config.dims == 1:
+        engine_decl = "#define DECONV_1D\t\t\t\t\t// ConvTranspose1d over the W samples of an H = 1 input\n\n"
+    if config.resize:
+        engine_decl = (f"#define DECONV_RESIZE_CONV\t\t\t// resize by S, then stride-1 convolution\n"
+                       f"constexpr unsigned  RESIZE = {RESIZE_MODES[config.resize][1]};\t\t// {config.resize}\n\n")
+        if config.resize == 'bilinear':
+            # Bilinear activations carry a (2S)^2 scale, see src/resize_conv.hpp
+            out_bits += 2 * (2 * config.S - 1).bit_length()
+
     header_template = f"""#ifndef DECONV_TOP_HPP
 #define DECONV_TOP_HPP
 
@@ -148,9 +367,16 @@ def generate_header_file(config: DeconvConfig, pe_simd_configs: List[Tuple[int,
 #include <hls_stream.h>
 #include <hls_vector.h>
 
-constexpr unsigned  K = {config.K};		// kernel Size
+{engine_decl}constexpr unsigned  K = {config.K};		// kernel Size
 constexpr unsigned  S = {config.S}; 		// stride
+constexpr unsigned  D = {config.D};		// dilation
 constexpr unsigned  P = {config.P};		// padding
+constexpr unsigned  PT = {config.P};		// padding top
+constexpr unsigned  PB = {config.PB};		// padding bottom
+constexpr unsigned  PL = {config.PL};		// padding left
+constexpr unsigned  PR = {config.PR};		// padding right
+constexpr unsigned  OPH = {config.OP};		// output padding (bottom)
+constexpr unsigned  OPW = {config.OP};		// output padding (right)
 constexpr unsigned  H = {config.H};		// IFM height
 constexpr unsigned  W = {config.W};		// IFM Width
 constexpr unsigned  CI = {config.CI};		// input channels
@@ -158,7 +384,7 @@ constexpr unsigned  CO = {config.CO};		// output channels
 
 using  TW = ap_uint< 8>;
 using  TI = ap_uint< 4>;
-using  TO = ap_uint<16>;
+using  TO = ap_uint<{out_bits}>;
 
 """
     
@@ -194,6 +420,12 @@ void deconv_top(
     return full_content
 
 
+def _optional_int(row: Dict, key: str):
+    """Integer CSV column that older config tables may lack or leave empty."""
+    value = row.get(key)
+    return int(value) if value not in (None, "") else None
+
+
 def load_configs_from_csv(csv_path: Path, exp_data_dir: Path = None) -> List[Dict]:
     """Load configurations from CSV file and find associated data files"""
     configurations = []
@@ -204,14 +436,23 @@ def load_configs_from_csv(csv_path: Path, exp_data_dir: Path = None) -> List[Dic
         reader = csv.DictReader(f)
         for row in reader:
             try:
+                dims = _optional_int(row, 'dims') or 2
                 config = DeconvConfig(
                     K=int(row['kernel_size']),
                     S=int(row['stride']),
-                    H=int(row['input_size']),
+                    H=1 if dims == 1 else int(row['input_size']),
                     W=int(row['input_size']),
                     CI=int(row['in_channels']),
                     CO=int(row['out_channels']),
-                    P=int(row['padding'])
+                    P=int(row['padding']),
+                    PB=_optional_int(row, 'padding_bottom'),
+                    PL=_optional_int(row, 'padding_left'),
+                    PR=_optional_int(row, 'padding_right'),
+                    OP=_optional_int(row, 'output_padding') or 0,
+                    D=_optional_int(row, 'dilation') or 1,
+                    resize=row.get('resize') or "",
+                    sparsity=row.get('sparsity') or "",
+                    dims=dims,
                 )
                 configurations.append(config)
                 print(f"  Loaded: {config}")
@@ -240,7 +481,7 @@ def load_configs_from_csv(csv_path: Path, exp_data_dir: Path = None) -> List[Dic
         }
         
         for cfg in valid_configs:
-            base = f"deconv_{cfg.H}x{cfg.W}_in{cfg.CI}_out{cfg.CO}_k{cfg.K}_s{cfg.S}_p{cfg.P}"
+            base = cfg.data_basename()
             files = {}
             all_present = True
             
@@ -358,6 +599,12 @@ Examples:
   
   # Specify experimental data directory for weights
   python generate_deconv_configs.py --exp-data /path/to/exp_data
+  
+  # Benchmark the conv + depth-to-space rewrite next to each native layer
+  python generate_deconv_configs.py --depth-to-space
+
+  # Benchmark the MM2IM engine next to each native layer
+  python generate_deconv_configs.py --mm2im
         """
     )
     
@@ -375,6 +622,18 @@ Examples:
         help='Path to experimental data directory containing weights files (default: DeConv_benchmark path)'
     )
     
+    parser.add_argument(
+        '--depth-to-space',
+        action='store_true',
+        help='Also emit the conv + depth-to-space rewrite (_PS<S> headers) of every strided layer with S | K'
+    )
+    
+    parser.add_argument(
+        '--mm2im',
+        action='store_true',
+        help='Also emit the MM2IM engine (_MM<S> headers) of every transposed convolution'
+    )
+    
     parser.add_argument(
         '--output',
         type=Path,
@@ -404,7 +663,20 @@ Examples:
     # Generate header files
     generated_files = []
     
-    for i, de_config in enumerate(config_groups):
+    variants = []
+    for de_config in config_groups:
+        variants.append(de_config)
+        config = de_config['config']
+        if args.depth_to_space and config.supports_d2s():
+            rewrite = copy.copy(config)
+            rewrite.d2s = True
+            variants.append({**de_config, 'config': rewrite})
+        if args.mm2im and config.supports_mm2im():
+            engine = copy.copy(config)
+            engine.mm2im = True
+            variants.append({**de_config, 'config': engine})
+    
+    for i, de_config in enumerate(variants):
         config = de_config['config']
         weights_file = de_config['files'].get('weights')
         
@@ -413,7 +685,7 @@ Examples:
         
         # Generate header content with padding in filename
         header_content = generate_header_file(config, pe_simd_configs, weights_path=weights_file)
-        filename = f"deconv_top_K{config.K}_S{config.S}_H{config.H}_W{config.W}_CI{config.CI}_CO{config.CO}_P{config.P}.hpp"
+        filename = f"deconv_top_{config.tag()}.hpp"
         filepath = args.output / filename
         
         # Write to file
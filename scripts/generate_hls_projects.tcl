@@ -20,10 +20,65 @@ set PROJECTS_DIR "${BASE_DIR}/hls_projects"
 # HLS Settings
 # Zynq UltraScale+ device
 set TARGET_DEVICE "xczu3eg-sbva484-1-i"
-set CLOCK_PERIOD "5"             
+# Clock sweep: one solution per PE/SIMD tuple and target period (ns).
+# Override with e.g. DECONV_CLOCK_PERIODS="5 4 3.3 2.5"
+set CLOCK_PERIODS {5}
+if {[info exists ::env(DECONV_CLOCK_PERIODS)] && [string trim $::env(DECONV_CLOCK_PERIODS)] != ""} {
+    set CLOCK_PERIODS $::env(DECONV_CLOCK_PERIODS)
+}
 set RESET_TYPE "sync"         
 set RESET_POLARITY "active_high"
 
+# Compiler flags for design and testbench sources.
+# DECONV_CSIM_BOUNDED=1 makes C simulation honour the declared stream depths
+# (DECONV_CSIM_PORT_DEPTH sets the depth assumed for the top-level ports).
+# DECONV_TB_FRAMES=N streams N frames back to back through csim and cosim.
+# DECONV_BATCH=B builds the batch-interleaved design (B images per frame).
+# DECONV_MVU=systolic|cascade replaces the broadcast MVU by the systolic PE
+# chain or by the DSP cascade SIMD reduction; DECONV_MVU=fused lets the MVU
+# address the kernel ROM itself instead of reading the weight stream.
+# DECONV_ENCODE=bitmap|delta appends the output encoder (output_codec.hpp);
+# the testbench decodes dst before checking it.
+# DECONV_TILE=XxY applies every weight beat to an X x Y tile of window
+# positions (deconv_tiled()), cutting the weight stream by X*Y.
+# DECONV_HEADS=NH tests deconv_multi() with NH heads in csim in place of
+# deconv_top(); head h uses the kernel with its output channels rotated by h.
+# DECONV_MAXI=1 adds the m_axi frame movers deconv_maxi_read() and
+# deconv_maxi_write() as kernels of their own, one project each next to the
+# deconv_top() project, and lets the testbench move its frames through them.
+set CFLAGS "-std=c++14"
+set TOP deconv_top
+set MAXI_TOPS {}
+if {[info exists ::env(DECONV_TB_FRAMES)] && $::env(DECONV_TB_FRAMES) > 1} {
+    append CFLAGS " -DDECONV_TB_FRAMES=$::env(DECONV_TB_FRAMES)"
+}
+if {[info exists ::env(DECONV_BATCH)] && $::env(DECONV_BATCH) > 1} {
+    append CFLAGS " -DDECONV_BATCH=$::env(DECONV_BATCH)"
+}
+if {[info exists ::env(DECONV_MVU)] && $::env(DECONV_MVU) != ""} {
+    append CFLAGS " -DDECONV_MVU=DECONV_MVU_[string toupper $::env(DECONV_MVU)]"
+}
+if {[info exists ::env(DECONV_ENCODE)] && $::env(DECONV_ENCODE) != ""} {
+    append CFLAGS " -DDECONV_ENCODE=DECONV_ENCODE_[string toupper $::env(DECONV_ENCODE)]"
+}
+if {[info exists ::env(DECONV_TILE)] && $::env(DECONV_TILE) != ""} {
+    lassign [split [string tolower $::env(DECONV_TILE)] x] tile_x tile_y
+    append CFLAGS " -DDECONV_TILE_X=$tile_x -DDECONV_TILE_Y=$tile_y"
+}
+if {[info exists ::env(DECONV_HEADS)] && $::env(DECONV_HEADS) > 1} {
+    append CFLAGS " -DDECONV_HEADS=$::env(DECONV_HEADS)"
+}
+if {[info exists ::env(DECONV_MAXI)] && $::env(DECONV_MAXI)} {
+    append CFLAGS " -DDECONV_MAXI"
+    set MAXI_TOPS {deconv_maxi_read deconv_maxi_write}
+}
+if {[info exists ::env(DECONV_CSIM_BOUNDED)] && $::env(DECONV_CSIM_BOUNDED)} {
+    append CFLAGS " -DDECONV_CSIM_BOUNDED"
+    if {[info exists ::env(DECONV_CSIM_PORT_DEPTH)]} {
+        append CFLAGS " -DDECONV_CSIM_PORT_DEPTH=$::env(DECONV_CSIM_PORT_DEPTH)"
+    }
+}
+
 # Global variable to store all project configurations for script generation
 set all_project_configs {}
 
@@ -50,9 +105,10 @@ proc log_warning {message} {
 
 # Extract configuration parameters from filename
 proc parse_config_filename {filename} {
-    # Expected format: deconv_top_K3_S1_H3_W3_CI1_CO3_P2.hpp
-    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)\.hpp} $filename match K S H W CI CO P]} {
-        return [list $K $S $H $W $CI $CO $P]
+    # Expected format: deconv_top_K3_S1_H3_W3_CI1_CO3_P2.hpp, optionally followed by
+    # asymmetric padding / output padding, e.g. ..._P0_PB1_PL0_PR1_OP1.hpp
+    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)((?:_[A-Z]+\d+)*)\.hpp} $filename match K S H W CI CO P EDGES]} {
+        return [list $K $S $H $W $CI $CO $P $EDGES]
     } else {
         return {}
     }
@@ -78,6 +134,11 @@ proc safe_copy_file {src dst} {
     }
 }
 
+# Solution name suffix encoding the target clock period (3.3 -> CLK3p3)
+proc clock_tag {period} {
+    return "CLK[string map {. p} $period]"
+}
+
 # Extract PE and SIMD values from header file
 proc extract_pe_simd_configs {header_file} {
     set configs {}
@@ -114,8 +175,8 @@ proc extract_pe_simd_configs {header_file} {
 # HLS Project Creation Functions
 # =============================================================================
 
-proc create_hls_project {project_name config_params pe_simd_configs config_file} {
-    global PROJECTS_DIR SRC_DIR TARGET_DEVICE CLOCK_PERIOD RESET_TYPE RESET_POLARITY
+proc create_hls_project {project_name config_params pe_simd_configs config_file {top deconv_top}} {
+    global PROJECTS_DIR SRC_DIR TARGET_DEVICE CLOCK_PERIODS RESET_TYPE RESET_POLARITY CFLAGS
     
     lassign $config_params K S H W CI CO
     set project_dir "${PROJECTS_DIR}/${project_name}"
@@ -130,7 +191,7 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
     open_project $project_dir
     
     # Set top function
-    set_top deconv_top
+    set_top $top
     
     # Add source files
     set success 1
@@ -138,7 +199,7 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
     # Copy and add the specific configuration header
     set config_dst "${project_dir}/deconv_top.hpp"
     if {[safe_copy_file $config_file $config_dst]} {
-        add_files $config_dst -cflags "-std=c++14"
+        add_files $config_dst -cflags $CFLAGS
     } else {
         set success 0
     }
@@ -146,7 +207,14 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
     # Add other source files
     set source_files {
         "deconv_top.cpp"
+        "deconv_top_frame.hpp"
+        "deconv_maxi_top.cpp"
+        "deconv_maxi_top.hpp"
         "deconv.hpp"
+        "resize_conv.hpp"
+        "mm2im.hpp"
+        "deconv1d.hpp"
+        "output_codec.hpp"
         "utils.hpp"
     }
     
@@ -154,7 +222,7 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
         set src_path "${SRC_DIR}/${src_file}"
         set dst_path "${project_dir}/${src_file}"
         if {[safe_copy_file $src_path $dst_path]} {
-            add_files $dst_path -cflags "-std=c++14"
+            add_files $dst_path -cflags $CFLAGS
         } else {
             set success 0
         }
@@ -164,37 +232,42 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
     set tb_src "${SRC_DIR}/deconv_tb.cpp"
     set tb_dst "${project_dir}/deconv_tb.cpp"
     if {[safe_copy_file $tb_src $tb_dst]} {
-        add_files -tb $tb_dst -cflags "-std=c++14 -Wno-unknown-pragmas"
+        add_files -tb $tb_dst -cflags "$CFLAGS -Wno-unknown-pragmas"
     } else {
         set success 0
     }
     
-    # Create solutions for each PE/SIMD configuration
+    # Create solutions for each PE/SIMD configuration and clock target
     set solution_count 1
     foreach pe_simd $pe_simd_configs {
         lassign $pe_simd pe simd
-        set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}"
-        
-        log_info "  Creating solution: $solution_name (PE=$pe, SIMD=$simd)"
-        
-        # Create solution
-        open_solution $solution_name
-        
-        # Set device and clock
-        set_part $TARGET_DEVICE
-        create_clock -period $CLOCK_PERIOD -name default
-        
-        # Configure reset
-        # config_reset -type $RESET_TYPE -sync $RESET_POLARITY
-        
-        # Add configuration-specific directives
-        set_directive_interface -mode ap_ctrl_none "deconv_top" return
-        set_directive_interface -mode axis "deconv_top" src
-        set_directive_interface -mode axis "deconv_top" dst
-        set_directive_dataflow "deconv_top"
-        
-        # Close solution
-        close_solution
+        foreach clock_period $CLOCK_PERIODS {
+            set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}_[clock_tag $clock_period]"
+            
+            log_info "  Creating solution: $solution_name (PE=$pe, SIMD=$simd, clock=${clock_period}ns)"
+            
+            # Create solution
+            open_solution $solution_name
+            
+            # Set device and clock
+            set_part $TARGET_DEVICE
+            create_clock -period $clock_period -name default
+            
+            # Configure reset
+            # config_reset -type $RESET_TYPE -sync $RESET_POLARITY
+            
+            # Add configuration-specific directives (the frame movers
+            # carry their m_axi/s_axilite/axis interfaces as pragmas)
+            if {$top == "deconv_top"} {
+                set_directive_interface -mode ap_ctrl_none "deconv_top" return
+                set_directive_interface -mode axis "deconv_top" src
+                set_directive_interface -mode axis "deconv_top" dst
+                set_directive_dataflow "deconv_top"
+            }
+            
+            # Close solution
+            close_solution
+        }
         
         incr solution_count
     }
@@ -216,11 +289,12 @@ proc create_hls_project {project_name config_params pe_simd_configs config_file}
 # =============================================================================
 
 proc main {} {
-    global CONFIG_DIR PROJECTS_DIR all_project_configs
+    global CONFIG_DIR PROJECTS_DIR CLOCK_PERIODS MAXI_TOPS all_project_configs
     
     log_info "Starting HLS project generation"
     log_info "Configuration directory: $CONFIG_DIR"
     log_info "Projects directory: $PROJECTS_DIR"
+    log_info "Clock sweep (ns): $CLOCK_PERIODS"
     
     # Ensure projects directory exists
     ensure_directory $PROJECTS_DIR
@@ -250,7 +324,7 @@ proc main {} {
         
         # Parse configuration parameters
         set config_params [parse_config_filename $filename]
-        if {[llength $config_params] != 7} {
+        if {[llength $config_params] != 8} {
             log_error "Could not parse configuration from filename: $filename"
             continue
         }
@@ -260,20 +334,26 @@ proc main {} {
         log_info "  Found [llength $pe_simd_configs] PE/SIMD configurations"
         
         # Create project name
-        lassign $config_params K S H W CI CO P
-        set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}"
+        lassign $config_params K S H W CI CO P EDGES
+        set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}${EDGES}"
         
         # Store configuration for script generation
         set solution_count 1
         foreach pe_simd $pe_simd_configs {
             lassign $pe_simd pe simd
-            set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}"
-            set full_config [dict create \
-                K $K S $S H $H W $W CI $CI CO $CO \
-                PE $pe SIMD $simd \
-                project_name $project_name \
-                solution_name $solution_name]
-            lappend all_project_configs $full_config
+            # csim is clock-independent: only the first sweep point is simulated
+            set primary 1
+            foreach clock_period $CLOCK_PERIODS {
+                set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}_[clock_tag $clock_period]"
+                set full_config [dict create \
+                    K $K S $S H $H W $W CI $CI CO $CO \
+                    PE $pe SIMD $simd \
+                    clock_period $clock_period primary $primary \
+                    project_name $project_name \
+                    solution_name $solution_name]
+                lappend all_project_configs $full_config
+                set primary 0
+            }
             incr solution_count
         }
         
@@ -282,6 +362,13 @@ proc main {} {
         if {[create_hls_project $project_name $config_params $pe_simd_configs $config_file]} {
             incr successful_projects
         }
+        # Frame movers, e.g. deconv_K4_..._maxi_read for deconv_maxi_read()
+        foreach top $MAXI_TOPS {
+            incr total_projects
+            if {[create_hls_project "${project_name}_[string range $top 7 end]" $config_params $pe_simd_configs $config_file $top]} {
+                incr successful_projects
+            }
+        }
         
         log_info "Completed processing: $filename"
         puts ""
@@ -308,7 +395,7 @@ proc main {} {
 
 # Generate a batch synthesis script for all projects
 proc generate_synthesis_script {} {
-    global PROJECTS_DIR
+    global PROJECTS_DIR CFLAGS TOP MAXI_TOPS
     
     set script_file "${PROJECTS_DIR}/run_all_synthesis.tcl"
     set file_handle [open $script_file w]
@@ -316,6 +403,9 @@ proc generate_synthesis_script {} {
     puts $file_handle "# Auto-generated synthesis script for all deconv projects"
     puts $file_handle "# Usage (Vitis 2024.1+): vitis-run --mode hls --tcl run_all_synthesis.tcl"
     puts $file_handle "# Usage (Legacy):       vivado_hls -f run_all_synthesis.tcl"
+    puts $file_handle "# Set DECONV_RUN_IMPL=1 to also run Vivado implementation (post-route timing)"
+    puts $file_handle ""
+    puts $file_handle "set run_impl \[expr \{\[info exists ::env(DECONV_RUN_IMPL)\] && \$::env(DECONV_RUN_IMPL)\}\]"
     puts $file_handle ""
     
     # Find all project directories
@@ -323,17 +413,30 @@ proc generate_synthesis_script {} {
     
     foreach project_dir $project_dirs {
         set project_name [file tail $project_dir]
+        set top $TOP
+        foreach maxi_top $MAXI_TOPS {
+            if {[string match "*_[string range $maxi_top 7 end]" $project_name]} {
+                set top $maxi_top
+            }
+        }
         puts $file_handle "# Synthesize project: $project_name"
         puts $file_handle "puts \"Synthesizing project: $project_name\""
         puts $file_handle "open_project $project_dir"
-        puts $file_handle "set_top deconv_top"
+        puts $file_handle "set_top $top"
         puts $file_handle ""
         puts $file_handle "# Re-add source files to ensure they are properly loaded"
-        puts $file_handle "add_files \{${project_dir}/deconv_top.hpp\} -cflags \"-std=c++14\""
-        puts $file_handle "add_files \{${project_dir}/deconv_top.cpp\} -cflags \"-std=c++14\""
-        puts $file_handle "add_files \{${project_dir}/deconv.hpp\} -cflags \"-std=c++14\""
-        puts $file_handle "add_files \{${project_dir}/utils.hpp\} -cflags \"-std=c++14\""
-        puts $file_handle "add_files -tb \{${project_dir}/deconv_tb.cpp\} -cflags \"-std=c++14 -Wno-unknown-pragmas\""
+        puts $file_handle "add_files \{${project_dir}/deconv_top.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv_top.cpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv_top_frame.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv_maxi_top.cpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv_maxi_top.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/resize_conv.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/mm2im.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/deconv1d.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/output_codec.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files \{${project_dir}/utils.hpp\} -cflags \"$CFLAGS\""
+        puts $file_handle "add_files -tb \{${project_dir}/deconv_tb.cpp\} -cflags \"$CFLAGS -Wno-unknown-pragmas\""
         puts $file_handle ""
         
         # Find all solutions in the project
@@ -346,6 +449,13 @@ proc generate_synthesis_script {} {
             puts $file_handle "    puts \"ERROR: Synthesis failed for $solution_name: \$result\""
             puts $file_handle "\} else \{"
             puts $file_handle "    puts \"SUCCESS: Synthesis completed for $solution_name\""
+            puts $file_handle "    if \{\$run_impl\} \{"
+            puts $file_handle "        if \{\[catch \{export_design -flow impl -rtl verilog -format ip_catalog\} result\]\} \{"
+            puts $file_handle "            puts \"ERROR: Implementation failed for $solution_name: \$result\""
+            puts $file_handle "        \} else \{"
+            puts $file_handle "            puts \"SUCCESS: Implementation completed for $solution_name\""
+            puts $file_handle "        \}"
+            puts $file_handle "    \}"
             puts $file_handle "\}"
             puts $file_handle "close_solution"
         }
@@ -436,6 +546,9 @@ proc generate_csim_script {} {
     # Generate csim commands for each configuration
     foreach config $all_project_configs {
         dict with config {
+            if {!$primary} {
+                continue
+            }
             set project_dir $project_name
             
             puts $file_handle "# C Simulation for $project_name/$solution_name"
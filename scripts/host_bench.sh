@@ -0,0 +1,104 @@
+#!/usr/bin/env bash
+
+# Host Benchmark of the deconv<> C Simulation Model with Hardware Counters
+# -----------------------------------------------------------------------------
+# Compiles src/deconv_bench.cpp once per generated configuration header and
+# runs it, bracketing every run (and, with --stages, every dataflow stage) with
+# perf_event counters: cycles, instructions, cache misses and branch misses.
+# One JSON report per configuration is written to the output directory.
+#
+# Usage:
+#   scripts/host_bench.sh [options] [config_header ...]
+#
+# Options:
+#   --runs <n>        Timed runs per configuration (default: 5)
+#   --frames <n>      Frames streamed back to back per run (default: 1)
+#   --stages          Also attribute counters to the individual stages
+#   --batch <n>       Images interleaved per frame (DECONV_BATCH, default: 1)
+#   --mvu <impl>      MVU implementation: broadcast | systolic | cascade | fused
+#                     (DECONV_MVU, default: broadcast)
+#   --encode <mode>   Output encoding: none | bitmap | delta
+#                     (DECONV_ENCODE, default: none)
+#   --tile <x>x<y>    Output tile of window positions per weight beat
+#                     (DECONV_TILE_X/_Y, default: 1x1)
+#   --out-dir <dir>   Directory for JSON reports (default: bench_results)
+#
+# Environment:
+#   HLS_INCLUDE   Directory with ap_int.h/hls_stream.h (default: $XILINX_HLS/include)
+#   CXX           Host compiler (default: g++)
+#
+# Counters need perf_event access (/proc/sys/kernel/perf_event_paranoid <= 2);
+# without it the reports only contain wall time.
+# -----------------------------------------------------------------------------
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BASE_DIR="$(dirname "$SCRIPT_DIR")"
+CXX="${CXX:-g++}"
+HLS_INCLUDE="${HLS_INCLUDE:-${XILINX_HLS:-}/include}"
+
+runs="5"
+frames="1"
+stages=""
+batch="1"
+mvu="broadcast"
+encode="none"
+tile="1x1"
+out_dir="${BASE_DIR}/bench_results"
+headers=()
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --runs)    runs="$2"; shift 2 ;;
+    --frames)  frames="$2"; shift 2 ;;
+    --stages)  stages="--stages"; shift ;;
+    --batch)   batch="$2"; shift 2 ;;
+    --mvu)     mvu="$2"; shift 2 ;;
+    --encode)  encode="$2"; shift 2 ;;
+    --tile)    tile="$2"; shift 2 ;;
+    --out-dir) out_dir="$2"; shift 2 ;;
+    -h|--help) sed -n '3,32p' "$0"; exit 0 ;;
+    *)         headers+=("$(realpath "$1")"); shift ;;
+  esac
+done
+
+if [[ ${#headers[@]} -eq 0 ]]; then
+  headers=("${BASE_DIR}"/generated_configs/deconv_top_K*.hpp)
+fi
+if [[ ! -f "${HLS_INCLUDE}/ap_int.h" ]]; then
+  echo "[ERROR] ap_int.h not found in '${HLS_INCLUDE}' (source Vitis settings or set HLS_INCLUDE)" >&2
+  exit 1
+fi
+
+mkdir -p "$out_dir"
+build_dir="$(mktemp -d)"
+trap 'rm -rf "$build_dir"' EXIT
+
+failed=0
+for header in "${headers[@]}"; do
+  name="$(basename "$header" .hpp)"
+  name="${name#deconv_top_}"
+  echo "[INFO] Benchmarking: $name"
+  # Sources are compiled from the build directory so that their quoted
+  # includes pick up this header rather than src/deconv_top.hpp
+  cp -f "${BASE_DIR}"/src/*.hpp "${BASE_DIR}"/src/*.cpp "$build_dir"/
+  cp -f "$header" "${build_dir}/deconv_top.hpp"
+  if ! "$CXX" -std=c++14 -O2 -Wno-unknown-pragmas -DDECONV_BATCH="$batch" \
+      -DDECONV_MVU="DECONV_MVU_${mvu^^}" -DDECONV_ENCODE="DECONV_ENCODE_${encode^^}" \
+      -DDECONV_TILE_X="${tile%x*}" -DDECONV_TILE_Y="${tile#*x}" \
+      -I"$build_dir" -I"$HLS_INCLUDE" \
+      "${build_dir}/deconv_bench.cpp" -o "${build_dir}/deconv_bench" 2> "${build_dir}/build.log"; then
+    echo "[ERROR] Build failed for $name:" >&2
+    head -20 "${build_dir}/build.log" >&2
+    failed=$((failed + 1))
+    continue
+  fi
+  if ! "${build_dir}/deconv_bench" --runs "$runs" --frames "$frames" $stages \
+      --json "${out_dir}/${name}.json"; then
+    failed=$((failed + 1))
+  fi
+done
+
+echo "[INFO] Reports: $out_dir"
+[[ $failed -eq 0 ]]
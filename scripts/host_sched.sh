@@ -0,0 +1,93 @@
+#!/usr/bin/env bash
+
+# Multi-Stream Scheduling on the deconv<> C Simulation Model
+# -----------------------------------------------------------------------------
+# Compiles src/deconv_sched.cpp with deconv_top.cpp once per generated
+# configuration header and replays several periodic frame streams with
+# priorities and deadlines through it (see the header of deconv_sched.cpp).
+# Reports queueing delay, tail latency and deadline misses per stream; one
+# JSON report per configuration is written to the output directory.
+#
+# Usage:
+#   scripts/host_sched.sh [options] [config_header ...]
+#
+# Options:
+#   --stream <spec>     name:priority:period[:deadline[:burst]], repeatable
+#                       (default: rt:2:4f:2f and bulk:0:1.5f:0:2)
+#   --policy <p>        priority, edf or fifo (default: priority)
+#   --duration-ms <t>   Simulated arrival window (default: 10)
+#   --fmax <MHz>        Accelerator clock (default: 200)
+#   --aging-us <a>      Priority aging interval, 0 = off (default: 0)
+#   --batch <n>         Images interleaved per dispatch (DECONV_BATCH, default: 1)
+#   --out-dir <dir>     Directory for JSON reports (default: sched_results)
+#
+# Environment:
+#   HLS_INCLUDE   Directory with ap_int.h/hls_stream.h (default: $XILINX_HLS/include)
+#   CXX           Host compiler (default: g++)
+# -----------------------------------------------------------------------------
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BASE_DIR="$(dirname "$SCRIPT_DIR")"
+CXX="${CXX:-g++}"
+HLS_INCLUDE="${HLS_INCLUDE:-${XILINX_HLS:-}/include}"
+
+streams=()
+sched_args=()
+batch="1"
+out_dir="${BASE_DIR}/sched_results"
+headers=()
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --stream)      streams+=(--stream "$2"); shift 2 ;;
+    --policy|--duration-ms|--fmax|--aging-us)
+                   sched_args+=("$1" "$2"); shift 2 ;;
+    --batch)       batch="$2"; shift 2 ;;
+    --out-dir)     out_dir="$2"; shift 2 ;;
+    -h|--help)     sed -n '3,27p' "$0"; exit 0 ;;
+    *)             headers+=("$(realpath "$1")"); shift ;;
+  esac
+done
+
+if [[ ${#streams[@]} -eq 0 ]]; then
+  streams=(--stream "rt:2:4f:2f" --stream "bulk:0:1.5f:0:2")
+fi
+if [[ ${#headers[@]} -eq 0 ]]; then
+  headers=("${BASE_DIR}"/generated_configs/deconv_top_K*.hpp)
+fi
+if [[ ! -f "${HLS_INCLUDE}/ap_int.h" ]]; then
+  echo "[ERROR] ap_int.h not found in '${HLS_INCLUDE}' (source Vitis settings or set HLS_INCLUDE)" >&2
+  exit 1
+fi
+
+mkdir -p "$out_dir"
+build_dir="$(mktemp -d)"
+trap 'rm -rf "$build_dir"' EXIT
+
+failed=0
+for header in "${headers[@]}"; do
+  name="$(basename "$header" .hpp)"
+  name="${name#deconv_top_}"
+  echo "[INFO] Scheduling: $name"
+  # Sources are compiled from the build directory so that their quoted
+  # includes pick up this header rather than src/deconv_top.hpp
+  cp -f "${BASE_DIR}"/src/*.hpp "${BASE_DIR}"/src/*.cpp "$build_dir"/
+  cp -f "$header" "${build_dir}/deconv_top.hpp"
+  if ! "$CXX" -std=c++14 -O2 -Wno-unknown-pragmas -DDECONV_BATCH="$batch" -I"$build_dir" -I"$HLS_INCLUDE" \
+      "${build_dir}/deconv_top.cpp" "${build_dir}/deconv_sched.cpp" \
+      -o "${build_dir}/deconv_sched" 2> "${build_dir}/build.log"; then
+    echo "[ERROR] Build failed for $name:" >&2
+    head -20 "${build_dir}/build.log" >&2
+    failed=$((failed + 1))
+    continue
+  fi
+  if ! "${build_dir}/deconv_sched" "${streams[@]}" ${sched_args[@]+"${sched_args[@]}"} \
+      --json "${out_dir}/${name}.json"; then
+    failed=$((failed + 1))
+  fi
+done
+
+echo "[INFO] Reports: $out_dir"
+[[ $failed -eq 0 ]]
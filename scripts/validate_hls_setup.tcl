@@ -13,6 +13,12 @@ set CONFIG_DIR "${BASE_DIR}/generated_configs"
 set SRC_DIR "${BASE_DIR}/src"
 set PROJECTS_DIR "${BASE_DIR}/hls_projects"
 
+# Clock sweep as applied by generate_hls_projects.tcl
+set CLOCK_PERIODS {5}
+if {[info exists ::env(DECONV_CLOCK_PERIODS)] && [string trim $::env(DECONV_CLOCK_PERIODS)] != ""} {
+    set CLOCK_PERIODS $::env(DECONV_CLOCK_PERIODS)
+}
+
 proc log_info {message} {
     puts "\[INFO\] $message"
 }
@@ -22,8 +28,8 @@ proc log_error {message} {
 }
 
 proc parse_config_filename {filename} {
-    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)\.hpp} $filename match K S H W CI CO P]} {
-        return [list $K $S $H $W $CI $CO $P]
+    if {[regexp {deconv_top_K(\d+)_S(\d+)_H(\d+)_W(\d+)_CI(\d+)_CO(\d+)_P(\d+)((?:_[A-Z]+\d+)*)\.hpp} $filename match K S H W CI CO P EDGES]} {
+        return [list $K $S $H $W $CI $CO $P $EDGES]
     } else {
         return {}
     }
@@ -64,12 +70,13 @@ proc extract_pe_simd_configs {header_file} {
 }
 
 proc validate_and_show_projects {} {
-    global CONFIG_DIR SRC_DIR PROJECTS_DIR
+    global CONFIG_DIR SRC_DIR PROJECTS_DIR CLOCK_PERIODS
     
     log_info "Validating project generation setup..."
     log_info "Configuration directory: $CONFIG_DIR"
     log_info "Source directory: $SRC_DIR"
     log_info "Projects directory: $PROJECTS_DIR"
+    log_info "Clock sweep (ns): $CLOCK_PERIODS"
     
     # Check if directories exist
     foreach dir [list $CONFIG_DIR $SRC_DIR] {
@@ -93,8 +100,8 @@ proc validate_and_show_projects {} {
         set filename [file tail $config_file]
         set config_params [parse_config_filename $filename]
         
-        if {[llength $config_params] == 7} {
-            lassign $config_params K S H W CI CO P
+        if {[llength $config_params] == 8} {
+            lassign $config_params K S H W CI CO P EDGES
             set pe_simd_configs [extract_pe_simd_configs $config_file]
             
             log_info "  $filename"
@@ -102,14 +109,16 @@ proc validate_and_show_projects {} {
             log_info "    PE/SIMD configs: $pe_simd_configs"
             
             # Show what project would be created
-            set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}"
+            set project_name "deconv_K${K}_S${S}_H${H}_W${W}_CI${CI}_CO${CO}_P${P}${EDGES}"
             log_info "    -> Would create project: $project_name"
             
             set solution_count 1
             foreach pe_simd $pe_simd_configs {
                 lassign $pe_simd pe simd
-                set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}"
-                log_info "       -> Solution: $solution_name"
+                foreach clock_period $CLOCK_PERIODS {
+                    set solution_name "solution${solution_count}_PE${pe}_SIMD${simd}_CLK[string map {. p} $clock_period]"
+                    log_info "       -> Solution: $solution_name"
+                }
                 incr solution_count
             }
         } else {
@@ -120,7 +129,7 @@ proc validate_and_show_projects {} {
     
     # Check source files
     log_info "Checking source files in $SRC_DIR:"
-    set required_files {deconv_top.cpp deconv.hpp utils.hpp deconv_tb.cpp}
+    set required_files {deconv_top.cpp deconv_top_frame.hpp deconv_maxi_top.cpp deconv_maxi_top.hpp deconv.hpp resize_conv.hpp mm2im.hpp deconv1d.hpp output_codec.hpp utils.hpp deconv_tb.cpp}
     
     foreach file $required_files {
         set file_path "${SRC_DIR}/${file}"
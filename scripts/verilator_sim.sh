@@ -0,0 +1,127 @@
+#!/usr/bin/env bash
+
+# Verilator RTL Simulation of an Exported deconv_top Solution
+# -----------------------------------------------------------------------------
+# Builds the Verilog produced by C synthesis of one solution
+# (<solution>/syn/verilog/*.v) together with src/deconv_axis_driver.cpp into a
+# cycle-accurate simulator and streams the configuration's benchmark input
+# through it, checking every output beat against the golden tensor.
+# Neither Vitis nor a simulator licence is needed on the test machine.
+#
+# Usage:
+#   scripts/verilator_sim.sh <solution_dir> [options]
+#
+# Options:
+#   --frames <n>      Frames streamed back to back (default: 4)
+#   --ready <pct>     Probability (%) that dst_TREADY is asserted (default: 100)
+#   --valid <pct>     Probability (%) that src_TVALID is offered (default: 100)
+#   --seed <int>      Seed for the stall pattern (default: 1)
+#   --data-dir <dir>  Benchmark exp_data directory (default: deconv_data/exp_data)
+#   --ti-bits <n>     Input element width (default: 4)
+#   --to-bits <n>     Output element width (default: 16)
+#   --batch <n>       Images interleaved per frame, as synthesized with
+#                     DECONV_BATCH (default: 1)
+#
+# Example:
+#   scripts/verilator_sim.sh hls_projects/deconv_K3_S1_H5_W5_CI1_CO3_P1/solution1_PE1_SIMD1_CLK5 \
+#       --frames 8 --ready 70
+# -----------------------------------------------------------------------------
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BASE_DIR="$(dirname "$SCRIPT_DIR")"
+VERILATOR="${VERILATOR:-verilator}"
+
+frames="4"
+ready="100"
+valid="100"
+seed="1"
+data_dir="${BASE_DIR}/deconv_data/exp_data"
+ti_bits="4"
+to_bits="16"
+batch="1"
+
+if [[ $# -lt 1 ]]; then
+  sed -n '3,27p' "$0"
+  exit 1
+fi
+solution_dir="$(realpath "$1")"; shift
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --frames)   frames="$2"; shift 2 ;;
+    --ready)    ready="$2"; shift 2 ;;
+    --valid)    valid="$2"; shift 2 ;;
+    --seed)     seed="$2"; shift 2 ;;
+    --data-dir) data_dir="$2"; shift 2 ;;
+    --ti-bits)  ti_bits="$2"; shift 2 ;;
+    --to-bits)  to_bits="$2"; shift 2 ;;
+    --batch)    batch="$2"; shift 2 ;;
+    *) echo "Unknown argument: $1" >&2; exit 1 ;;
+  esac
+done
+
+if ! command -v "$VERILATOR" &> /dev/null; then
+  echo "[ERROR] verilator not found in PATH (override with VERILATOR=<exe>)" >&2
+  exit 1
+fi
+
+project_name="$(basename "$(dirname "$solution_dir")")"
+solution_name="$(basename "$solution_dir")"
+if [[ ! "$project_name" =~ deconv_K([0-9]+)_S([0-9]+)_H([0-9]+)_W([0-9]+)_CI([0-9]+)_CO([0-9]+)_P([0-9]+)((_[A-Z]+[0-9]+)*) ]]; then
+  echo "[ERROR] Cannot parse configuration from project name: $project_name" >&2
+  exit 1
+fi
+K=${BASH_REMATCH[1]}; S=${BASH_REMATCH[2]}; H=${BASH_REMATCH[3]}; W=${BASH_REMATCH[4]}
+CI=${BASH_REMATCH[5]}; CO=${BASH_REMATCH[6]}; P=${BASH_REMATCH[7]}
+edges=${BASH_REMATCH[8]}  # asymmetric padding / output padding tags, e.g. _PB1_PL0_PR1_OP1
+if [[ ! "$solution_name" =~ _PE([0-9]+)_SIMD([0-9]+) ]]; then
+  echo "[ERROR] Cannot parse PE/SIMD from solution name: $solution_name" >&2
+  exit 1
+fi
+PE=${BASH_REMATCH[1]}; SIMD=${BASH_REMATCH[2]}
+
+rtl_dir="${solution_dir}/syn/verilog"
+if [[ ! -f "${rtl_dir}/deconv_top.v" ]]; then
+  echo "[ERROR] Exported RTL not found: ${rtl_dir}/deconv_top.v (run synthesis first)" >&2
+  exit 1
+fi
+
+# The conv + depth-to-space rewrite (_PS<S>) and MM2IM (_MM<S>) share the
+# golden data of their layer
+tags=$(echo "${edges,,}" | sed -E 's/_(ps|mm)[0-9]+//g')
+data_base="${data_dir}/deconv_${H}x${W}_in${CI}_out${CO}_k${K}_s${S}_p${P}${tags}"
+for f in "${data_base}_input.csv" "${data_base}_output.csv"; do
+  if [[ ! -f "$f" ]]; then
+    echo "[ERROR] Benchmark data not found: $f" >&2
+    exit 1
+  fi
+done
+
+rst_active_low=0
+grep -q "ap_rst_n" "${rtl_dir}/deconv_top.v" && rst_active_low=1
+
+build_dir="${solution_dir}/verilator"
+mkdir -p "$build_dir"
+
+echo "[INFO] Configuration : K=$K S=$S H=$H W=$W CI=$CI CO=$CO P=$P${edges} PE=$PE SIMD=$SIMD"
+echo "[INFO] RTL           : $rtl_dir"
+echo "[INFO] Build dir     : $build_dir"
+
+"$VERILATOR" --cc --exe --build -j 0 -O3 --x-assign fast --x-initial fast \
+  --top-module deconv_top -Wno-fatal -Wno-lint -Wno-style \
+  -Mdir "$build_dir" \
+  -CFLAGS "-O2 -DK=$K -DS=$S -DH=$H -DW=$W -DCI=$CI -DCO=$CO -DP=$P -DPE=$PE -DSIMD=$SIMD" \
+  -CFLAGS "-DTI_BITS=$ti_bits -DTO_BITS=$to_bits -DDECONV_RST_ACTIVE_LOW=$rst_active_low -DDECONV_BATCH=$batch" \
+  "${rtl_dir}"/*.v "${BASE_DIR}/src/deconv_axis_driver.cpp" > "${build_dir}/build.log" 2>&1 || {
+    echo "[ERROR] Verilator build failed, see ${build_dir}/build.log" >&2
+    exit 1
+  }
+
+# ROM initialization files are loaded relative to the working directory
+cp -f "${rtl_dir}"/*.dat "$build_dir"/ 2> /dev/null || true
+
+cd "$build_dir"
+./Vdeconv_top "${data_base}_input.csv" "${data_base}_output.csv" "$frames" "$ready" "$valid" "$seed" \
+  | tee "${build_dir}/sim.log"
@@ -22,10 +22,14 @@
 
 //- Feature Map Cropping ----------------------------------------------------
 template<
-	unsigned  P,	// Cropping to remove from all individual edges
+	unsigned  PT,	// Rows to remove from the top edge
+	unsigned  PB,	// Rows to remove from the bottom edge
+	unsigned  PL,	// Columns to remove from the left edge
+	unsigned  PR,	// Columns to remove from the right edge
 	unsigned  H,	// IFM Height
 	unsigned  W,	// IFM Width
 	unsigned  C,	// IFM Channel Count
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
 	size_t    SIMD,
 	typename  T
 >
@@ -46,9 +50,9 @@ void crop(
 #pragma HLS reset variable=w
 #pragma HLS reset variable=d
 
-	if(!src.empty()) {
+	if(!stream_full(dst) && !src.empty()) {
 		auto const  x = src.read();
-		if((P <= w) && (w < W-P) && (P <= h) && (h < H-P))  dst.write(x);
+		if((PL <= w) && (w < W-PR) && (PT <= h) && (h < H-PB))  dst.write(x);
 		if(++d == C/SIMD) {
 			d = 0;
 			if(++w == W) {
@@ -61,7 +65,10 @@ void crop(
 } // crop()
 
 template<
-	unsigned  P,	// Padding to all individual edges
+	unsigned  PT,	// Rows to add at the top edge
+	unsigned  PB,	// Rows to add at the bottom edge
+	unsigned  PL,	// Columns to add at the left edge
+	unsigned  PR,	// Columns to add at the right edge
 	unsigned  H,	// IFM Height
 	unsigned  W,	// IFM Width
 	unsigned  C,	// IFM Channel Count
@@ -88,9 +95,11 @@ void pad(
 #pragma HLS reset variable=w
 #pragma HLS reset variable=d
 
+	if(stream_full(dst))  return;
+
 	bool  wr = false;
 	hls::vector<T, SIMD>  y;
-	if((h < P) || (P+H <= h) || (w < P) || (P+W <= w)) {
+	if((h < PT) || (PT+H <= h) || (w < PL) || (PL+W <= w)) {
 		wr = true;
 		for(unsigned  i = 0; i < SIMD; i++) {
 #pragma HLS unroll
@@ -105,113 +114,353 @@ void pad(
 		dst.write(y);
 		if(++d == C/SIMD) {
 			d = 0;
-			if(++w == P+W+P) {
+			if(++w == PL+W+PR) {
 				w = 0;
-				if(++h == P+H+P)  h = 0;
+				if(++h == PT+H+PB)  h = 0;
 			}
 		}
 	}
 
 } // pad()
 
-//===========================================================================
-// Deconv Building Blocks
-
+//- Depth-to-Space Reordering (Pixel Shuffle) -------------------------------
 template<
-	unsigned  K,	// kernel Size
-	unsigned  S, 	// stride
-	unsigned  H,	// IFM height
+	unsigned  S,	// block size
 	unsigned  W,	// IFM Width
-	unsigned  CF,	// channel fold (CO/PE)
-	unsigned  SF,	// SIMD fold (CI/SIMD)
-	size_t    PE,
-	size_t    SIMD,
-	typename  TW
+	unsigned  CF,	// beats per output pixel (C/PE)
+	typename  T
 >
-void deconv_weights(
-	TW const (&kernel)[CF*K*K*SF][PE][SIMD],
-	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &dst
+void depth_to_space(
+	hls::stream<T> &src,
+	hls::stream<T> &dst
 ) {
 #pragma HLS interface ap_ctrl_none port=return
 
 #pragma HLS pipeline II=1 style=flp
-	static_assert(K%S == 0, "Stride must divide kernel size.");
-	constexpr unsigned  KK = K/S;
+	// Input pixels carry S*S output pixels as channel groups ordered by their
+	// row and column offset within the SxS block. A full input row is
+	// collected into one half of a double buffer and emitted as S output rows
+	// while the next input row fills the other half.
+	constexpr unsigned  ROW = W*S*S*CF;
+	static T  buf[2][ROW];
+#pragma HLS array_partition variable=buf dim=1 complete
+	static bool  full[2] = { false, false };
+#pragma HLS array_partition variable=full complete
+#pragma HLS reset variable=full
 
-	static unsigned  idx = SF*(K+1)*(K-S);
-	static unsigned  y = 0;
-	static unsigned  sy = 0;
-	static unsigned  x = 0;
-	static unsigned  sx = 0;
-	static unsigned  c = 0;
-	static unsigned  ksy = 0;
-	static unsigned  ksx = 0;
-	static unsigned  d = 0;
-#pragma HLS reset variable=idx
-#pragma HLS reset variable=y
-#pragma HLS reset variable=sy
-#pragma HLS reset variable=x
-#pragma HLS reset variable=sx
+	// Output: sub-row sh, input column w, sub-column sw, channel beat c
+	static bool      rsel = false;
+	static unsigned  sh = 0;
+	static unsigned  w  = 0;
+	static unsigned  sw = 0;
+	static unsigned  c  = 0;
+#pragma HLS reset variable=rsel
+#pragma HLS reset variable=sh
+#pragma HLS reset variable=w
+#pragma HLS reset variable=sw
 #pragma HLS reset variable=c
-#pragma HLS reset variable=ksy
-#pragma HLS reset variable=ksx
-#pragma HLS reset variable=d
+	if(full[rsel] && !stream_full(dst)) {
+		dst.write(buf[rsel][((w*S + sh)*S + sw)*CF + c]);
+		if(c != CF-1)  c++;
+		else {
+			c = 0;
+			if(sw != S-1)  sw++;
+			else {
+				sw = 0;
+				if(w != W-1)  w++;
+				else {
+					w = 0;
+					if(sh != S-1)  sh++;
+					else {
+						sh = 0;
+						full[rsel] = false;
+						rsel = !rsel;
+					}
+				}
+			}
+		}
+	}
 
-#pragma HLS array_partition variable=kernel dim=1
-	hls::vector<hls::vector<TW, SIMD>, PE>  v;
-	for(unsigned  i = 0; i < PE; i++) {
-#pragma HLS unroll
-		for(unsigned  j = 0; j < SIMD; j++) {
-#pragma HLS unroll
-			v[i][j] = kernel[idx][i][j];
+	// Input: in arrival order
+	static bool      wsel = false;
+	static unsigned  widx = 0;
+#pragma HLS reset variable=wsel
+#pragma HLS reset variable=widx
+	if(!full[wsel]) {
+		T  x;
+		if(src.read_nb(x)) {
+			buf[wsel][widx] = x;
+			if(widx != ROW-1)  widx++;
+			else {
+				widx = 0;
+				full[wsel] = true;
+				wsel = !wsel;
+			}
+		}
+	}
+
+} // depth_to_space()
+
+//- Output-Tile Reordering ----------------------------------------------------
+template<
+	unsigned  S,	// stride: output rows and columns per window position
+	unsigned  TX,	// tile width in window positions
+	unsigned  TY,	// tile height in window positions
+	unsigned  WT,	// tiles per row of window positions
+	unsigned  CB,	// beats per output pixel
+	typename  T
+>
+void untile(
+	hls::stream<T> &src,
+	hls::stream<T> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	// Tiled engines complete the TY*TX output pixels of a tile position
+	// (sh, wt, sx) per beat cb, i.e. in the order sh, wt, sx, cb, ty, tx. A
+	// band of TY*S output rows is collected into one half of a double buffer
+	// and emitted in raster order while the next band fills the other half.
+	constexpr unsigned  WO = WT*TX*S;	// output pixels per row
+	constexpr unsigned  BAND = TY*S*WO*CB;
+	static T  buf[2][BAND];
+#pragma HLS array_partition variable=buf dim=1 complete
+	static bool  full[2] = { false, false };
+#pragma HLS array_partition variable=full complete
+#pragma HLS reset variable=full
+
+	// Output: in raster order
+	static bool      rsel = false;
+	static unsigned  ridx = 0;
+#pragma HLS reset variable=rsel
+#pragma HLS reset variable=ridx
+	if(full[rsel] && !stream_full(dst)) {
+		dst.write(buf[rsel][ridx]);
+		if(ridx != BAND-1)  ridx++;
+		else {
+			ridx = 0;
+			full[rsel] = false;
+			rsel = !rsel;
+		}
+	}
+
+	// Input: sub-row sh, tile wt, sub-column sx, beat cb, tile row ty and column tx
+	static bool      wsel = false;
+	static unsigned  sh = 0;
+	static unsigned  wt = 0;
+	static unsigned  sx = 0;
+	static unsigned  cb = 0;
+	static unsigned  ty = 0;
+	static unsigned  tx = 0;
+#pragma HLS reset variable=wsel
+#pragma HLS reset variable=sh
+#pragma HLS reset variable=wt
+#pragma HLS reset variable=sx
+#pragma HLS reset variable=cb
+#pragma HLS reset variable=ty
+#pragma HLS reset variable=tx
+	if(!full[wsel]) {
+		T  x;
+		if(src.read_nb(x)) {
+			buf[wsel][((ty*S + sh)*WO + (wt*TX + tx)*S + sx)*CB + cb] = x;
+			if(tx != TX-1)  tx++;
+			else {
+				tx = 0;
+				if(ty != TY-1)  ty++;
+				else {
+					ty = 0;
+					if(cb != CB-1)  cb++;
+					else {
+						cb = 0;
+						if(sx != S-1)  sx++;
+						else {
+							sx = 0;
+							if(wt != WT-1)  wt++;
+							else {
+								wt = 0;
+								if(sh != S-1)  sh++;
+								else {
+									sh = 0;
+									full[wsel] = true;
+									wsel = !wsel;
+								}
+							}
+						}
+					}
+				}
+			}
 		}
 	}
 
-	if(dst.write_nb(v)) {
+} // untile()
+
+//- Dilation Phases ----------------------------------------------------------
+// A kernel dilated by D places tap k at output offset D*k. For D coprime to
+// S, the output rows of phase s (mod S) receive the taps k = tap(s) (mod S),
+// D*tap(s) = s (mod S), which read input rows D apart. Relative to the other
+// phases, their first row is offset(s) rows down, so that a window of all
+// phases spans D*(K/S-1) + SKEW + 1 input rows. D = 1 yields tap(s) = s and
+// offset(s) = 0, the plain phase decomposition.
+
+// Inverse of D modulo S, S if there is none
+constexpr unsigned deconv_dilation_inverse(unsigned  S, unsigned  D) {
+	unsigned  r = 0;
+	while((r < S) && ((D*r)%S != 1%S))  r++;
+	return  r;
+}
+
+// Largest row skew (D*tap(s) - s)/S of any phase s
+constexpr unsigned deconv_dilation_skew(unsigned  S, unsigned  D) {
+	unsigned const  inv = deconv_dilation_inverse(S, D);
+	unsigned  m = 0;
+	for(unsigned  s = 0; s < S; s++) {
+		unsigned const  k = (D*((s*inv)%S) - s)/S;
+		if(k > m)  m = k;
+	}
+	return  m;
+}
+
+template<
+	unsigned  S, 	// stride
+	unsigned  D 	// dilation
+>
+struct deconv_dilation {
+	static constexpr unsigned  INV  = deconv_dilation_inverse(S, D);
+	static constexpr unsigned  SKEW = deconv_dilation_skew(S, D);
+	static_assert((D > 0) && (INV < S), "Dilation must be coprime to the stride.");
+
+	static constexpr unsigned  tap(unsigned  s) {
+		return  (D == 1)? s : (s*INV)%S;
+	}
+	static constexpr unsigned  offset(unsigned  s) {
+		return  (D == 1)? 0 : SKEW - (D*tap(s) - s)/S;
+	}
+};
+
+//- Edge Geometry of the Transposed Convolution ------------------------------
+// Padding and cropping per edge to accommodate (de)padding != K-S.
+// Output padding extends the bottom/right edges like ConvTranspose2d's
+// output_padding, i.e. it reduces their (de)padding and may extend the
+// output beyond the full transposed convolution, where it is zero.
+// A dilated kernel extends over KF = D*(K-1)+1 outputs and its windows over
+// KW input rows and columns, see deconv_dilation.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  D = 1	// dilation
+>
+struct deconv_geometry {
+	static constexpr unsigned  KF = D*(K-1) + 1;
+	static constexpr unsigned  KW = D*(K/S-1) + deconv_dilation<S, D>::SKEW + 1;
+	static constexpr unsigned  A  = S*(KW-1);	// full output row of the first window
+	static constexpr unsigned  PADT = (PT >= A)?          0 : (A-PT+S-1)/S;
+	static constexpr unsigned  PADB = (PB >= KF-S+OPH)?   0 : (KF+OPH-PB-1)/S;
+	static constexpr unsigned  PADL = (PL >= A)?          0 : (A-PL+S-1)/S;
+	static constexpr unsigned  PADR = (PR >= KF-S+OPW)?   0 : (KF+OPW-PR-1)/S;
+	static constexpr unsigned  CROPT = S*PADT + PT - A;
+	static constexpr unsigned  CROPB = S*PADB + PB - (KF-S) - OPH;
+	static constexpr unsigned  CROPL = S*PADL + PL - A;
+	static constexpr unsigned  CROPR = S*PADR + PR - (KF-S) - OPW;
+	static constexpr unsigned  H_EFF = PADT + H + PADB;
+	static constexpr unsigned  W_EFF = PADL + W + PADR;
+	static constexpr unsigned  HO_EFF = (H_EFF-KW+1)*S;
+	static constexpr unsigned  WO_EFF = (W_EFF-KW+1)*S;
+};
+
+//===========================================================================
+// Deconv Building Blocks
+
+//- Kernel Beat Sequence -----------------------------------------------------
+// Position of the walk through the kernel beats [CO/PE][K][K][CI/SIMD] that
+// matches the window order of deconv_swg(). idx is the next beat to apply.
+struct deconv_weight_pos {
+	unsigned  idx;
+	unsigned  y, sy, x, sx;	// window (tile) position and output phase
+	unsigned  c, ksy, ksx, d;	// channel fold, kernel tap and SIMD fold
+};
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  SF	// SIMD fold (CI/SIMD)
+>
+constexpr deconv_weight_pos deconv_weight_start() {
+	return  { SF*(K+1)*(K-S), 0, 0, 0, 0, 0, 0, 0, 0 };
+}
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CF,	// channel fold (CO/PE)
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	unsigned  TX = 1,	// output tile width: window positions per weight beat
+	unsigned  TY = 1,	// output tile height
+	unsigned  D = 1	// dilation
+>
+void deconv_weight_next(deconv_weight_pos &p) {
+#pragma HLS inline
+	static_assert(K%S == 0, "Stride must divide kernel size.");
+	constexpr unsigned  KK = K/S;
+	using  Dl = deconv_dilation<S, D>;	// phase s starts at kernel tap K-S + tap(s)
+	constexpr unsigned  KW = D*(KK-1) + Dl::SKEW + 1;	// window rows and columns
 
 //std::cout
-//	<< '|' << y << ':' << sy << ':' << x << ':' << sx << ':' << c << ':' << ksy << ':' << ksx << ':' << d
+//	<< '|' << p.y << ':' << p.sy << ':' << p.x << ':' << p.sx << ':' << p.c << ':' << p.ksy << ':' << p.ksx << ':' << p.d
 //	<< std::endl;
-		signed  delta = 1;
-		if(d != SF-1)  d++;	// [c,ky,kx,d] += [0,0,0,1]
+	signed  delta = 1;
+	if(p.d != SF-1)  p.d++;	// [c,ky,kx,d] += [0,0,0,1]
+	else {
+		p.d = 0;
+
+		delta -= SF*(S+1);	// [c,ky,kx,d] += [0,0,-S,-SF]
+		if(p.ksx != KK-1)  p.ksx++;
 		else {
-			d = 0;
+			p.ksx = 0;
 
-			delta -= SF*(S+1);	// [c,ky,kx,d] += [0,0,-S,-SF]
-			if(ksx != KK-1)  ksx++;
+			delta -= SF*K*(S-1);	// [c,ky,kx,d] += [0,-S,K,0]
+			if(p.ksy != KK-1)  p.ksy++;
 			else {
-				ksx = 0;
+				p.ksy = 0;
 
-				delta -= SF*K*(S-1);	// [c,ky,kx,d] += [0,-S,K,0]
-				if(ksy != KK-1)  ksy++;
+				delta += 2*SF*K*K;	// [c,ky,kx,d] += [1,K,0,0]
+				if(p.c != CF-1)  p.c++;
 				else {
-					ksy = 0;
+					p.c = 0;
 
-					delta += 2*SF*K*K;	// [c,ky,kx,d] += [1,K,0,0]
-					if(c != CF-1)  c++;
+					delta -= SF*CF*K*K;	// [c,ky,kx,d] += [-CF,0,0,0]
+					if(p.sx != S-1) {
+						delta += SF*(signed(Dl::tap(p.sx+1)) - signed(Dl::tap(p.sx)));	// [c,ky,kx,d] += [0,0,tap(sx+1)-tap(sx),0]
+						p.sx++;
+					}
 					else {
-						c = 0;
+						delta -= SF*Dl::tap(S-1);	// [c,ky,kx,d] += [0,0,-tap(S-1),0]
+						p.sx = 0;
 
-						delta -= SF*(CF*K*K-1);	// [c,ky,kx,d] += [-CF,0,1,0]
-						if(sx != S-1)  sx++;
+						if(p.x != W-KW+1-TX)  p.x += TX;
 						else {
-							sx = 0;
+							p.x = 0;
 
-							delta -= SF*S;	// [c,ky,kx,d] += [0,0,-S,0]
-							if(x != W-KK)  x++;
+							if(p.sy != S-1) {
+								delta += SF*K*(signed(Dl::tap(p.sy+1)) - signed(Dl::tap(p.sy)));	// [c,ky,kx,d] += [0,tap(sy+1)-tap(sy),0,0]
+								p.sy++;
+							}
 							else {
-								x = 0;
+								delta -= SF*K*Dl::tap(S-1);	// [c,ky,kx,d] += [0,-tap(S-1),0,0]
+								p.sy = 0;
 
-								delta += SF*K;	// [c,ky,kx,d] += [0,1,0,0]
-								if(sy != S-1)  sy++;
+								if(p.y != H-KW+1-TY)  p.y += TY;
 								else {
-									sy = 0;
-
-									delta -= SF*K*S;	// [c,ky,kx,d] += [0,-S,0,0]
-									if(y != H-KK)  y++;
-									else {
-										y = 0;
-									}
+									p.y = 0;
 								}
 							}
 						}
@@ -219,11 +468,85 @@ void deconv_weights(
 				}
 			}
 		}
-		idx += delta;
+	}
+	p.idx += delta;
+
+} // deconv_weight_next()
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CF,	// channel fold (CO/PE)
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
+	unsigned  TX = 1,	// output tile width: window positions per weight beat
+	unsigned  TY = 1,	// output tile height
+	unsigned  D = 1,	// dilation
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW
+>
+void deconv_weights(
+	TW const (&kernel)[CF*K*K*SF][PE][SIMD],
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static deconv_weight_pos  pos = deconv_weight_start<K, S, SF>();
+#pragma HLS reset variable=pos
+
+#pragma HLS array_partition variable=kernel dim=1
+	hls::vector<hls::vector<TW, SIMD>, PE>  v;
+	for(unsigned  i = 0; i < PE; i++) {
+#pragma HLS unroll
+		for(unsigned  j = 0; j < SIMD; j++) {
+#pragma HLS unroll
+			v[i][j] = kernel[pos.idx][i][j];
+		}
+	}
+
+	if(!stream_full(dst) && dst.write_nb(v)) {
+		deconv_weight_next<K, S, H, W, CF, SF, TX, TY, D>(pos);
 	}
 
 } // deconv_weights()
 
+template<
+	unsigned  N,	// kernel beats (CF*K*K*SF) of a stride-1 window
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW
+>
+void conv_weights(
+	TW const (&kernel)[N][PE][SIMD],
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static unsigned  idx = 0;
+#pragma HLS reset variable=idx
+
+#pragma HLS array_partition variable=kernel dim=1
+	hls::vector<hls::vector<TW, SIMD>, PE>  v;
+	for(unsigned  i = 0; i < PE; i++) {
+#pragma HLS unroll
+		for(unsigned  j = 0; j < SIMD; j++) {
+#pragma HLS unroll
+			v[i][j] = kernel[idx][i][j];
+		}
+	}
+
+	if(!stream_full(dst) && dst.write_nb(v)) {
+		if(idx != N-1)  idx++;
+		else  idx = 0;
+	}
+
+} // conv_weights()
+
 template<
 	unsigned  K,	// kernel Size
 	unsigned  S, 	// stride
@@ -231,6 +554,13 @@ template<
 	unsigned  W,	// IFM Width
 	unsigned  CF,	// channel fold (CO/PE)
 	unsigned  SF,	// SIMD fold (CI/SIMD)
+	unsigned  PT = 0,	// virtual zero rows above the IFM
+	unsigned  PB = 0,	// virtual zero rows below the IFM
+	unsigned  PL = 0,	// virtual zero columns left of the IFM
+	unsigned  PR = 0,	// virtual zero columns right of the IFM
+	unsigned  TX = 1,	// output tile width: window positions emitted per beat group
+	unsigned  TY = 1,	// output tile height
+	unsigned  D = 1,	// dilation: window rows and columns D apart
 	typename  T		// e.g. hls::vector<TI, SIMD>
 >
 void deconv_swg(
@@ -242,36 +572,67 @@ void deconv_swg(
 #pragma HLS pipeline II=1 style=flp
 	static_assert(K%S == 0, "Stride must divide kernel size.");
 	constexpr unsigned  KK = K/S;
-	constexpr unsigned  ADDR_BITS = clog2(KK*W*SF);
+	using  Dl = deconv_dilation<S, D>;	// phase s reads its taps offset(s) + D*k
+	constexpr unsigned  KW = D*(KK-1) + Dl::SKEW + 1;	// window rows and columns
+	constexpr unsigned  H_EFF = PT + H + PB;
+	constexpr unsigned  W_EFF = PL + W + PR;
+	static_assert((H_EFF-KW+1)%TY == 0, "Tile height must divide the window rows.");
+	static_assert((W_EFF-KW+1)%TX == 0, "Tile width must divide the window columns.");
+	constexpr unsigned  KY = KW+TY-1;	// rows spanned by a tile of windows
+	constexpr unsigned  KX = KW+TX-1;	// columns spanned by a tile of windows
+
+	// The KY rows of the current tile position are only released as a whole
+	// (TY rows when the tile moves down, all KY at the end of a frame). The
+	// lookahead lets the input run ahead by the first KY-1 rows and KX pixels
+	// of the next position so that the next tile, and in particular the first
+	// tile of the next frame, is ready when the current one drains.
+	constexpr unsigned  LOOKAHEAD = ((KY-1)*W + KX)*SF;
+	constexpr unsigned  ADDR_BITS = clog2(KY*W*SF + LOOKAHEAD);
 
-	// Cyclic buffer with wrapping pointers, pointers have an extra MSB beyond the memory address space to capture buffer generations
-	//	- wp & cp increment monotonously, rp wiggles between them
+	// Cyclic buffer of real (unpadded) pixels with wrapping pointers, pointers have an extra MSB beyond the memory address space to capture buffer generations
+	//	- wp & cp increment monotonously, the read address lies between them
 	//	- read can proceed if rp < wp
 	//	- cp <= rp < cp', rp cannot rewind below cp
 	//	- wp <= cp', write can proceed if wp < cp' (cp of next buffer generation)
+	// Padding is virtual: window positions outside the IFM read as zero
+	// without occupying buffer space or input cycles. They are held back
+	// until the first pixel of their frame has arrived, so that the windows
+	// of a frame never run ahead of its input, even those without a real
+	// tap, as dilated windows may have.
 	static T  buf[1<<ADDR_BITS];
 #pragma HLS dependence variable=buf inter direction=WAR false
 #pragma HLS dependence variable=buf inter direction=RAW distance=1 true
 	using  ptr_t = ap_int<1+ADDR_BITS>;
 	constexpr unsigned  WP_DEPTH = 4;	// TODO: Why do we need 4? How does this relate to `distance` above?
 	static ptr_t  wp[WP_DEPTH] = { 0, };	// incl. delayed pointers for guarding read progession
-	static ptr_t  rp = 0;
-	static ptr_t  cp = 0;
+	static ptr_t  fp = 0;	// first pixel of the current frame
+	static ptr_t  cp = 0;	// first row still referenced by the current frame
+	static bool   started = false;	// the first pixel of the current frame has arrived
 #pragma HLS array_partition variable=wp complete
 #pragma HLS reset variable=wp
-#pragma HLS reset variable=rp
+#pragma HLS reset variable=fp
 #pragma HLS reset variable=cp
+#pragma HLS reset variable=started
 
 	/*
 	// Produce output in this scheme:
-	for(unsigned  h = 0; h < H-KK+1; h++) {
+	for(unsigned  h = 0; h < H_EFF-KW+1; h += TY) {
 		for(unsigned  sh = 0; sh < S; sh++) {
-			for(unsigned  w = 0; w < W-KK+1; w++) {
-				for(unsigned  sw = 0; sw < S*CF; sw++) {
-					for(unsigned  kh = 0; kh < KK; kh++) {
-						for(unsigned  kw = 0; kw < KK; kw++) {
-							for(unsigned  d = 0; d < SF; d++) {
-								emit(img[h+kh, w+kw, d]);
+			for(unsigned  w = 0; w < W_EFF-KW+1; w += TX) {
+				for(unsigned  sw = 0; sw < S; sw++) {
+					for(unsigned  cf = 0; cf < CF; cf++) {
+						for(unsigned  kh = 0; kh < KK; kh++) {
+							for(unsigned  kw = 0; kw < KK; kw++) {
+								for(unsigned  d = 0; d < SF; d++) {
+									for(unsigned  ty = 0; ty < TY; ty++) {
+										for(unsigned  tx = 0; tx < TX; tx++) {
+											emit(padded_img[
+												h+ty + offset(sh) + D*kh,
+												w+tx + offset(sw) + D*kw, d
+											]);
+										}
+									}
+								}
 							}
 						}
 					}
@@ -284,53 +645,79 @@ void deconv_swg(
 	static unsigned  sh = 0;
 	static unsigned  w  = 0;
 	static unsigned  sw = 0;
+	static unsigned  cf = 0;
 	static unsigned  kh = 0;
 	static unsigned  kw = 0;
 	static unsigned  d  = 0;
+	static unsigned  ty = 0;
+	static unsigned  tx = 0;
 #pragma HLS reset variable=h
 #pragma HLS reset variable=sh
 #pragma HLS reset variable=w
 #pragma HLS reset variable=sw
+#pragma HLS reset variable=cf
 #pragma HLS reset variable=kh
 #pragma HLS reset variable=kw
 #pragma HLS reset variable=d
+#pragma HLS reset variable=ty
+#pragma HLS reset variable=tx
 
 	for(unsigned  i = WP_DEPTH-1; i > 0; i--)  wp[i] = wp[i-1];
-	if(/* rp < wp */ ptr_t(rp-wp[WP_DEPTH-1]) < 0) {
-		T const  y = buf[ap_uint<ADDR_BITS>(rp)];
-		if(dst.write_nb(y)) {
-			signed    rinc = 1;	// default: one step forward
-			unsigned  cinc = 0;
 
-			if(d != SF-1)  d++;
+	// Position within the real IFM and its buffer address
+	signed const  r = signed(h + ty + Dl::offset(sh) + D*kh) - signed(PT);
+	signed const  c = signed(w + tx + Dl::offset(sw) + D*kw) - signed(PL);
+	bool   const  real = (0 <= r) && (r < signed(H)) && (0 <= c) && (c < signed(W));
+	ptr_t  const  rp = fp + ptr_t((r*signed(W) + c)*signed(SF) + signed(d));
+	// Latched, as wp may run further ahead of fp than ptr_t can compare once
+	// the rows of the frame have been released.
+	if(/* fp < wp */ ptr_t(fp-wp[WP_DEPTH-1]) < 0)  started = true;
+	if(real? /* rp < wp */ ptr_t(rp-wp[WP_DEPTH-1]) < 0 : started) {
+		T const  y = real? buf[ap_uint<ADDR_BITS>(rp)] : T(0);
+		if(!stream_full(dst) && dst.write_nb(y)) {
+			if(tx != TX-1)  tx++;
 			else {
-				d = 0;
-				if(kw != KK-1)  kw++;
+				tx = 0;
+				if(ty != TY-1)  ty++;
 				else {
-					kw = 0;
-					rinc += (W-KK)*SF;	// skip to next row of kernel volume
-					if(kh != KK-1)  kh++;
+					ty = 0;
+					if(d != SF-1)  d++;
 					else {
-						kh = 0;
-						rinc -= KK*W*SF;	// unskip back to beginning of kernel volume
-						if(sw != CF*S-1)  sw++;
+						d = 0;
+						if(kw != KK-1)  kw++;
 						else {
-							sw = 0;
-							rinc += SF;	// advance kernel position horizontally
-							if(w != W-KK)  w++;
+							kw = 0;
+							if(kh != KK-1)  kh++;
 							else {
-								w = 0;
-								rinc -= (W-KK+1)*SF;	// unskip row for repetition
-								if(sh != S-1)  sh++;
+								kh = 0;
+								if(cf != CF-1)  cf++;
 								else {
-									sh = 0;
-									rinc += W*SF;	// advance kernel position vertically
-									cinc = W*SF;
-									if(h != H-KK)  h++;
+									cf = 0;
+									if(sw != S-1)  sw++;
 									else {
-										h = 0;
-										rinc += (KK-1)*W*SF;	// skip shallow leftover rows
-										cinc = KK*W*SF;
+										sw = 0;
+										if(w != W_EFF-KW+1-TX)  w += TX;
+										else {
+											w = 0;
+											if(sh != S-1)  sh++;
+											else {
+												sh = 0;
+												if(h != H_EFF-KW+1-TY) {
+													// release the top TY rows as far as they are real ones
+													for(unsigned  i = 0; i < TY; i++) {
+#pragma HLS unroll
+														if((PT <= h+i) && (h+i < PT+H))  cp += W*SF;
+													}
+													h += TY;
+												}
+												else {
+													h = 0;
+													fp += H*W*SF;
+													cp = fp;
+													started = false;
+												}
+											}
+										}
 									}
 								}
 							}
@@ -338,8 +725,6 @@ void deconv_swg(
 					}
 				}
 			}
-			rp += rinc;
-			cp += cinc;
 		}
 	}
 
@@ -352,6 +737,8 @@ void deconv_swg(
 
 template<
 	unsigned  N,	// dot product depth
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
 	size_t    PE,
 	size_t    SIMD,
 	typename  TW,
@@ -366,30 +753,30 @@ void deconv_mvu(
 #pragma HLS interface ap_ctrl_none port=return
 
 #pragma HLS pipeline II=1 style=flp
-	static TO  accu[PE] = { 0, };
-	static ap_uint<clog2(N)>  cnt = 0;
+	// A weight beat is read with the activation of image b = 0 and held for
+	// the B-1 activations following it. Each image accumulates separately.
+	static hls::vector<hls::vector<TW, SIMD>, PE>  ww;
+	static TO  accu[B][PE] = { { 0, }, };
+	static hls::vector<TO, PE>  y;
+	static ap_uint<(N > 1)? clog2(N) : 1>  cnt = 0;
+	static unsigned  b = 0;
 	static bool  push = false;
-#pragma HLS array_partition variable=accu complete
+#pragma HLS array_partition variable=accu dim=2 complete
 #pragma HLS reset variable=accu
 #pragma HLS reset variable=cnt
+#pragma HLS reset variable=b
 #pragma HLS reset variable=push
 
 	// Complete marked Output
-	if(push) {
-		hls::vector<TO, PE>  y;
-		for(unsigned  pe = 0; pe < PE; pe++) {
-#pragma HLS unroll
-			y[pe] = accu[pe];
-			accu[pe] = 0;
-		}
+	if(push && !stream_full(dst)) {
 		dst.write(y);
 		push = false;
 	}
 
-	if(!wgt.empty() && !src.empty()) {
+	if(!push && ((b != 0) || !wgt.empty()) && !src.empty()) {
 
 		// Broadcast activation to all PEs in parallel
-		auto const  ww = wgt.read();
+		if(b == 0)  ww = wgt.read();
 		auto const  a  = src.read();
 		for(unsigned  pe = 0; pe < PE; pe++) {
 #pragma HLS unroll
@@ -400,77 +787,951 @@ void deconv_mvu(
 				p += w[i] * a[i];
 //std::cout << "+= " << w[i] << " * " << a[i] << std::endl;
 			}
-			accu[pe] += p;
+			TO const  acc = accu[b][pe] + p;
+			if(cnt < N-1)  accu[b][pe] = acc;
+			else {
+				y[pe] = acc;
+				accu[b][pe] = 0;
+			}
 		}
 
 		// Mark for Output
-		if(cnt < N-1)  cnt++;
+		if(cnt == N-1)  push = true;
+		if(b < B-1)  b++;
 		else {
-			cnt = 0;
-			push = true;
+			b = 0;
+			if(cnt < N-1)  cnt++;
+			else  cnt = 0;
 		}
 
 	}
 
 } // deconv_mvu()
 
-
+//- Systolic MVU ------------------------------------------------------------
+// Drop-in alternative to deconv_mvu() without the activation broadcast. A
+// beat enters the chain at PE 0 and shifts one PE per cycle. Every chain
+// register carries the activation, the weights of the PEs still ahead and the
+// results of the PEs already passed, so that each PE only talks to its
+// neighbours. The weight and result skews form two triangular register
+// arrays. The output vector is complete when a final beat leaves the last PE.
+// The chain advances every cycle it is not blocked on the output, inserting
+// bubbles when no input is available, so throughput matches deconv_mvu() at
+// a latency of PE cycles more.
 template<
-	unsigned  K,	// kernel Size
-	unsigned  S, 	// stride
-	unsigned  P,	// (de)padding
-	unsigned  H,	// IFM height
-	unsigned  W,	// IFM Width
-	unsigned  CO,	// output channels
-	unsigned  CI,	// input channels
+	unsigned  N,	// dot product depth
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
 	size_t    PE,
 	size_t    SIMD,
 	typename  TW,
 	typename  TI,
 	typename  TO
 >
-void deconv(
-	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
-	hls::stream<hls::vector<TI, SIMD>> &src,
-	hls::stream<hls::vector<TO, PE>>   &dst
+void deconv_mvu_systolic(
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &wgt,
+	hls::stream<hls::vector<TI, SIMD>>                  &src,
+	hls::stream<hls::vector<TO, PE>>                    &dst
 ) {
 #pragma HLS interface ap_ctrl_none port=return
-#pragma HLS dataflow disable_start_propagation
 
-	// Parameter Validation & Fold Derivation
-	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
-	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
-	constexpr unsigned  CF = CO/PE;
-	constexpr unsigned  SF = CI/SIMD;
+#pragma HLS pipeline II=1 style=flp
+	// Chain entry: weight beat held for B activations as in deconv_mvu()
+	static hls::vector<hls::vector<TW, SIMD>, PE>  ww;
+	static ap_uint<(N > 1)? clog2(N) : 1>  cnt = 0;
+	static unsigned  b = 0;
 
-	// Padding and cropping values to accommodate P != K-S
-	constexpr unsigned  PADUP = (P >= K-S)? 0 : (K-P-1)/S;
-	constexpr unsigned  CROP  = S*PADUP - ((K-S)-P);
-	constexpr unsigned  H_EFF = PADUP + H + PADUP;
-	constexpr unsigned  W_EFF = PADUP + W + PADUP;
-	constexpr unsigned  HO_EFF = (H_EFF+1)*S - K;
-	constexpr unsigned  WO_EFF = (W_EFF+1)*S - K;
+	// Chain registers in front of every PE
+	static bool  vld[PE] = { false, };	// carries a beat
+	static bool  fin[PE];			// last beat of its dot product
+	static unsigned  img[PE];		// image of the batch
+	static hls::vector<TI, SIMD>  act[PE];
+	static hls::vector<TW, SIMD>  wsk[PE][PE];	// [pe][q]: weights of PE q >= pe
+	static TO  ysk[PE][PE];			// [pe][q]: results of PE q < pe
 
-	// Continuous Weight Feed
-	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
-#pragma HLS stream depth=2 variable=wgt
-	deconv_weights<K, S, H_EFF, W_EFF, CF, SF>(kernel, wgt);
+	static TO  accu[B][PE] = { { 0, }, };
+	static hls::vector<TO, PE>  y;
+	static bool  push = false;
+#pragma HLS array_partition variable=vld complete
+#pragma HLS array_partition variable=fin complete
+#pragma HLS array_partition variable=img complete
+#pragma HLS array_partition variable=act complete
+#pragma HLS array_partition variable=wsk complete dim=0
+#pragma HLS array_partition variable=ysk complete dim=0
+#pragma HLS array_partition variable=accu dim=2 complete
+#pragma HLS reset variable=cnt
+#pragma HLS reset variable=b
+#pragma HLS reset variable=vld
+#pragma HLS reset variable=accu
+#pragma HLS reset variable=push
 
-	// Activation Processing Pipeline: pad -> swg -> mvu -> crop
-	static hls::stream<hls::vector<TI, SIMD>>  src_eff("src_eff");
-	static hls::stream<hls::vector<TI, SIMD>>  swg    ("swg");
-	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
-#pragma HLS stream depth=2 variable=src_eff
-#pragma HLS stream depth=2 variable=swg
-#pragma HLS stream depth=2 variable=dst_eff
+	// Complete marked Output
+	if(push && !stream_full(dst)) {
+		dst.write(y);
+		push = false;
+	}
 
-	pad<PADUP, H, W, CI>(src, src_eff, TI(0));
+	if(!push) {
+
+		// Advance the chain from its end so that every PE reads its own register
+		for(int  pe = PE-1; pe >= 0; pe--) {
+#pragma HLS unroll
+			TO  r = 0;
+			if(vld[pe]) {
+				auto const  w = wsk[pe][pe];
+				auto const  a = act[pe];
+				TO  p = 0;
+				for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS unroll
+					p += w[i] * a[i];
+				}
+				r = accu[img[pe]][pe] + p;
+				accu[img[pe]][pe] = fin[pe]? TO(0) : r;
+			}
 
-	deconv_swg<K, S, H_EFF, W_EFF, CF, SF>(src_eff, swg);
-	deconv_mvu<K/S*K/S*SF>(wgt, swg, dst_eff);
+			if(pe == PE-1) {
+				// Collect the deskewed output vector
+				if(vld[pe] && fin[pe]) {
+					for(unsigned  q = 0; q < PE-1; q++) {
+#pragma HLS unroll
+						y[q] = ysk[pe][q];
+					}
+					y[pe] = r;
+					push = true;
+				}
+			}
+			else {
+				vld[pe+1] = vld[pe];
+				fin[pe+1] = fin[pe];
+				img[pe+1] = img[pe];
+				act[pe+1] = act[pe];
+				for(unsigned  q = 0; q < PE; q++) {
+#pragma HLS unroll
+					if(q > unsigned(pe))  wsk[pe+1][q] = wsk[pe][q];
+					if(q < unsigned(pe))  ysk[pe+1][q] = ysk[pe][q];
+				}
+				ysk[pe+1][pe] = r;
+			}
+		}
 
-	crop<CROP, HO_EFF, WO_EFF, CO>(dst_eff, dst);
+		// Feed the chain, or insert a bubble
+		vld[0] = false;
+		if(((b != 0) || !wgt.empty()) && !src.empty()) {
+			if(b == 0)  ww = wgt.read();
+			act[0] = src.read();
+			for(unsigned  q = 0; q < PE; q++) {
+#pragma HLS unroll
+				wsk[0][q] = ww[q];
+			}
+			vld[0] = true;
+			fin[0] = cnt == N-1;
+			img[0] = b;
 
-} // deconv()
+			if(b < B-1)  b++;
+			else {
+				b = 0;
+				if(cnt < N-1)  cnt++;
+				else  cnt = 0;
+			}
+		}
+
+	}
+
+} // deconv_mvu_systolic()
+
+//- DSP Cascade MVU ---------------------------------------------------------
+// Alternative to deconv_mvu() that reduces the SIMD lanes of every PE through
+// a chain of SIMD multiply-adds instead of a fabric adder tree. The chain
+// matches the DSP48E2 cascade: stage i adds its product w[i]*a[i] to the
+// partial sum registered by stage i-1 (PCIN -> PCOUT), and the last stage
+// also adds the accumulator (P feedback). Operand lanes are skewed
+// accordingly. A beat enters stage 0 with all lanes, and lane j travels j
+// registers before it is used, so each lane reaches its multiplier in the
+// same cycle as the partial sum. Every PE is its own DSP column. Throughput
+// matches deconv_mvu(), and latency grows by SIMD cycles.
+template<
+	unsigned  N,	// dot product depth
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_mvu_cascade(
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &wgt,
+	hls::stream<hls::vector<TI, SIMD>>                  &src,
+	hls::stream<hls::vector<TO, PE>>                    &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	// Cascade entry: weight beat held for B activations as in deconv_mvu()
+	static hls::vector<hls::vector<TW, SIMD>, PE>  ww;
+	static ap_uint<(N > 1)? clog2(N) : 1>  cnt = 0;
+	static unsigned  b = 0;
+
+	// Registers in front of every cascade stage
+	static bool  vld[SIMD] = { false, };	// carries a beat
+	static bool  fin[SIMD];			// last beat of its dot product
+	static unsigned  img[SIMD];		// image of the batch
+	static TI  ask[SIMD][SIMD];		// [i][j]: activation lane j >= i
+	static TW  wsk[SIMD][PE][SIMD];		// [i][pe][j]: weight lane j >= i
+	static TO  psum[SIMD][PE];		// [i][pe]: partial sum of lanes < i
+
+	static TO  accu[B][PE] = { { 0, }, };
+	static hls::vector<TO, PE>  y;
+	static bool  push = false;
+#pragma HLS array_partition variable=vld complete
+#pragma HLS array_partition variable=fin complete
+#pragma HLS array_partition variable=img complete
+#pragma HLS array_partition variable=ask complete dim=0
+#pragma HLS array_partition variable=wsk complete dim=0
+#pragma HLS array_partition variable=psum complete dim=0
+#pragma HLS array_partition variable=accu dim=2 complete
+#pragma HLS reset variable=cnt
+#pragma HLS reset variable=b
+#pragma HLS reset variable=vld
+#pragma HLS reset variable=accu
+#pragma HLS reset variable=push
+
+	// Complete marked Output
+	if(push && !stream_full(dst)) {
+		dst.write(y);
+		push = false;
+	}
+
+	if(!push) {
+
+		// Advance the cascade from its end so that every stage reads its own register
+		for(int  i = SIMD-1; i >= 0; i--) {
+#pragma HLS unroll
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				TO const  m = wsk[i][pe][i] * ask[i][i];
+#pragma HLS bind_op variable=m op=mul impl=dsp
+				TO const  c = i == 0? TO(0) : psum[i][pe];
+				TO const  p = c + m;
+#pragma HLS bind_op variable=p op=add impl=dsp
+				if(i < int(SIMD-1))  psum[i+1][pe] = p;
+				else if(vld[i]) {
+					TO const  acc = accu[img[i]][pe] + p;
+					if(fin[i]) {
+						y[pe] = acc;
+						accu[img[i]][pe] = 0;
+					}
+					else  accu[img[i]][pe] = acc;
+				}
+			}
+
+			if(i == int(SIMD-1)) {
+				if(vld[i] && fin[i])  push = true;
+			}
+			else {
+				vld[i+1] = vld[i];
+				fin[i+1] = fin[i];
+				img[i+1] = img[i];
+				for(unsigned  j = i+1; j < SIMD; j++) {
+#pragma HLS unroll
+					ask[i+1][j] = ask[i][j];
+					for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+						wsk[i+1][pe][j] = wsk[i][pe][j];
+					}
+				}
+			}
+		}
+
+		// Feed the cascade, or insert a bubble
+		vld[0] = false;
+		if(((b != 0) || !wgt.empty()) && !src.empty()) {
+			if(b == 0)  ww = wgt.read();
+			auto const  a = src.read();
+			for(unsigned  j = 0; j < SIMD; j++) {
+#pragma HLS unroll
+				ask[0][j] = a[j];
+				for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+					wsk[0][pe][j] = ww[pe][j];
+				}
+			}
+			vld[0] = true;
+			fin[0] = cnt == N-1;
+			img[0] = b;
+
+			if(b < B-1)  b++;
+			else {
+				b = 0;
+				if(cnt < N-1)  cnt++;
+				else  cnt = 0;
+			}
+		}
+
+	}
+
+} // deconv_mvu_cascade()
+
+//- Fused Weight Sequencing MVU ----------------------------------------------
+// Alternative to deconv_weights() -> wgt -> deconv_mvu() that addresses the
+// kernel ROM itself. The kernel beat index follows the walk of
+// deconv_weights() and advances with every consumed group of B activations,
+// so the wide PE*SIMD*TW weight FIFO, its handshake and the held weight beat
+// disappear, and the MVU no longer stalls on the weight side. Schedule,
+// throughput and results equal those of deconv_mvu().
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  H,	// effective IFM height (incl. virtual padding)
+	unsigned  W,	// effective IFM Width (incl. virtual padding)
+	unsigned  CF,	// channel fold (CO/PE)
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
+	unsigned  TX = 1,	// output tile width: window positions per weight beat
+	unsigned  TY = 1,	// output tile height
+	unsigned  D = 1,	// dilation
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_mvu_fused(
+	TW const (&kernel)[CF*K*K*SF][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	constexpr unsigned  N = (K/S)*(K/S)*SF;	// dot product depth
+
+	static deconv_weight_pos  pos = deconv_weight_start<K, S, SF>();
+	static TO  accu[B][PE] = { { 0, }, };
+	static hls::vector<TO, PE>  y;
+	static ap_uint<(N > 1)? clog2(N) : 1>  cnt = 0;
+	static unsigned  b = 0;
+	static bool  push = false;
+#pragma HLS array_partition variable=accu dim=2 complete
+#pragma HLS reset variable=pos
+#pragma HLS reset variable=accu
+#pragma HLS reset variable=cnt
+#pragma HLS reset variable=b
+#pragma HLS reset variable=push
+
+	// Complete marked Output
+	if(push && !stream_full(dst)) {
+		dst.write(y);
+		push = false;
+	}
+
+#pragma HLS array_partition variable=kernel dim=1
+	if(!push && !src.empty()) {
+
+		// Broadcast activation to all PEs, weights straight from the ROM
+		auto const  a  = src.read();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			TO  p = 0;
+			for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS unroll
+				p += kernel[pos.idx][pe][i] * a[i];
+			}
+			TO const  acc = accu[b][pe] + p;
+			if(cnt < N-1)  accu[b][pe] = acc;
+			else {
+				y[pe] = acc;
+				accu[b][pe] = 0;
+			}
+		}
+
+		// Mark for Output
+		if(cnt == N-1)  push = true;
+		if(b < B-1)  b++;
+		else {
+			b = 0;
+			deconv_weight_next<K, S, H, W, CF, SF, TX, TY, D>(pos);
+			if(cnt < N-1)  cnt++;
+			else  cnt = 0;
+		}
+
+	}
+
+} // deconv_mvu_fused()
+
+//- MVU Selection -----------------------------------------------------------
+// Instantiates the MVU implementation chosen by DECONV_MVU (see utils.hpp).
+// DECONV_MVU_FUSED replaces the weight stream as a whole and is instantiated
+// by the engines that support it; the others fall back to deconv_mvu().
+template<
+	unsigned  N,	// dot product depth
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_mvu_sel(
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &wgt,
+	hls::stream<hls::vector<TI, SIMD>>                  &src,
+	hls::stream<hls::vector<TO, PE>>                    &dst
+) {
+#pragma HLS inline
+#if DECONV_MVU == DECONV_MVU_SYSTOLIC
+	deconv_mvu_systolic<N, B, ID>(wgt, src, dst);
+#elif DECONV_MVU == DECONV_MVU_CASCADE
+	deconv_mvu_cascade<N, B, ID>(wgt, src, dst);
+#else
+	deconv_mvu<N, B, ID>(wgt, src, dst);
+#endif
+} // deconv_mvu_sel()
+
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	unsigned  D = 1,	// dilation
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_asym(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+
+	using  G = deconv_geometry<K, S, PT, PB, PL, PR, OPH, OPW, H, W, D>;
+
+#if DECONV_MVU != DECONV_MVU_FUSED
+	// Continuous Weight Feed
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, deconv_weights<K, S, G::H_EFF, G::W_EFF, CF, SF, 0, 1, 1, D>(kernel, wgt));
+#endif
+
+	// Activation Processing Pipeline: swg (incl. virtual padding) -> mvu -> crop
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(dst_eff, 2);
+
+	// Batch interleaving: the B images of a beat position form an SF*B fold
+	// for the line buffer, and one weight beat serves B consecutive windows.
+	DECONV_STAGE(swg, deconv_swg<K, S, H, W, CF, SF*B, G::PADT, G::PADB, G::PADL, G::PADR, 1, 1, D>(src, swg));
+#if DECONV_MVU == DECONV_MVU_FUSED
+	DECONV_STAGE(mvu, deconv_mvu_fused<K, S, G::H_EFF, G::W_EFF, CF, SF, B, 0, 1, 1, D>(kernel, swg, dst_eff));
+#else
+	DECONV_STAGE(mvu, deconv_mvu_sel<K/S*K/S*SF, B>(wgt, swg, dst_eff));
+#endif
+
+	DECONV_STAGE(crop, crop<G::CROPT, G::CROPB, G::CROPL, G::CROPR, G::HO_EFF, G::WO_EFF, CO*B>(dst_eff, dst));
+
+} // deconv_asym()
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  P,	// (de)padding
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS inline
+	deconv_asym<K, S, P, P, P, P, 0, 0, H, W, CO, CI, PE, SIMD>(kernel, src, dst);
+} // deconv()
+
+//===========================================================================
+// Convolution + Depth-to-Space Rewrite
+
+// A stride-S transposed convolution with K = S*KK is a stride-1 KxK/S
+// convolution producing S*S*CO channels followed by depth-to-space:
+//	y[S*a+sh][S*b+sw] = sum_{i,j<KK} x[a-i][b-j] * w[S*i+sh][S*j+sw]
+// The window generator runs with stride 1, but still emits every window
+// S*S*CO/PE times: the S*S phase replays of deconv_swg<K, S> become S*S*CO/PE
+// channel groups of the convolution. Beats and cycles per frame are the same
+// as those of deconv_asym().
+// The kernel is rearranged offline (scripts/generate_deconv_configs.py) into
+//	kernel[(sh*S + sw)*CO/PE + cf][i][j][d] = w[S*(KK-1-i)+sh][S*(KK-1-j)+sw]
+// and replayed cyclically. Padding, output padding and cropping match
+// deconv_asym(), whose uncropped output has exactly the S*S-fold geometry of
+// the convolution on the padded IFM.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_d2s(
+	TW const (&kernel)[S*S*(CO/PE)*(K/S)*(K/S)*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(K%S == 0, "Stride must divide kernel size.");
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	constexpr unsigned  KK = K/S;
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+	using  G = deconv_geometry<K, S, PT, PB, PL, PR, OPH, OPW, H, W>;
+
+	// Continuous Weight Feed
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, conv_weights(kernel, wgt));
+
+	// Activation Processing Pipeline: swg (stride 1) -> mvu -> depth-to-space -> crop
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TO, PE>>  conv("conv");
+	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(conv, 2);
+	DECONV_STREAM_DEPTH(dst_eff, 2);
+
+	DECONV_STAGE(swg, deconv_swg<KK, 1, H, W, S*S*CF, SF*B, G::PADT, G::PADB, G::PADL, G::PADR>(src, swg));
+	DECONV_STAGE(mvu, deconv_mvu_sel<KK*KK*SF, B>(wgt, swg, conv));
+	DECONV_STAGE(d2s, depth_to_space<S, G::W_EFF-KK+1, CF*B>(conv, dst_eff));
+
+	DECONV_STAGE(crop, crop<G::CROPT, G::CROPB, G::CROPL, G::CROPR, G::HO_EFF, G::WO_EFF, CO*B>(dst_eff, dst));
+
+} // deconv_d2s()
+
+//===========================================================================
+// N:M Structured Sparsity
+
+// Kernels pruned to at most NN nonzero weights in every group of M
+// consecutive input channels are stored compressed: SIMD*NN/M weights per PE
+// and kernel beat, each with its position within its group of M lanes. The
+// position ROM has the same layout and is walked by a second deconv_weights()
+// instance. deconv_mvu_nm() selects the matching activation lane of every
+// stored weight through an M:1 multiplexer and reduces only SIMD*NN/M
+// products per PE. The MAC count drops to NN/M, throughput and latency stay
+// those of deconv_mvu(), and there is no balancing logic: every beat costs
+// one cycle regardless of the weight values.
+template<
+	unsigned  N,	// dot product depth
+	unsigned  M,	// input channels per sparsity group
+	unsigned  B = 1,	// batch: consecutive activations sharing each weight beat
+	unsigned  ID = 0,	// instance, separates the state of parallel copies
+	size_t    PE,
+	size_t    NZ,	// stored weights per PE and beat (SIMD*NN/M)
+	size_t    SIMD,
+	typename  TW,
+	typename  TX,	// weight position within its group, e.g. ap_uint<clog2(M)>
+	typename  TI,
+	typename  TO
+>
+void deconv_mvu_nm(
+	hls::stream<hls::vector<hls::vector<TW, NZ>, PE>> &wgt,
+	hls::stream<hls::vector<hls::vector<TX, NZ>, PE>> &pos,
+	hls::stream<hls::vector<TI, SIMD>>                &src,
+	hls::stream<hls::vector<TO, PE>>                  &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static_assert(SIMD%M == 0, "Sparsity groups must not straddle SIMD beats.");
+	static_assert((NZ*M)%SIMD == 0, "Stored weights must fill whole groups.");
+	constexpr unsigned  NN = NZ*M/SIMD;	// stored weights per group
+
+	// Same schedule as deconv_mvu(), position beats travel with the weights
+	static hls::vector<hls::vector<TW, NZ>, PE>  ww;
+	static hls::vector<hls::vector<TX, NZ>, PE>  pp;
+	static TO  accu[B][PE] = { { 0, }, };
+	static hls::vector<TO, PE>  y;
+	static ap_uint<(N > 1)? clog2(N) : 1>  cnt = 0;
+	static unsigned  b = 0;
+	static bool  push = false;
+#pragma HLS array_partition variable=accu dim=2 complete
+#pragma HLS reset variable=accu
+#pragma HLS reset variable=cnt
+#pragma HLS reset variable=b
+#pragma HLS reset variable=push
+
+	// Complete marked Output
+	if(push && !stream_full(dst)) {
+		dst.write(y);
+		push = false;
+	}
+
+	if(!push && ((b != 0) || (!wgt.empty() && !pos.empty())) && !src.empty()) {
+
+		if(b == 0) {
+			ww = wgt.read();
+			pp = pos.read();
+		}
+		auto const  a  = src.read();
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			TO  p = 0;
+			for(unsigned  i = 0; i < NZ; i++) {
+#pragma HLS unroll
+				// Lane i holds a weight of group i/NN
+				p += ww[pe][i] * a[(i/NN)*M + pp[pe][i]];
+			}
+			TO const  acc = accu[b][pe] + p;
+			if(cnt < N-1)  accu[b][pe] = acc;
+			else {
+				y[pe] = acc;
+				accu[b][pe] = 0;
+			}
+		}
+
+		// Mark for Output
+		if(cnt == N-1)  push = true;
+		if(b < B-1)  b++;
+		else {
+			b = 0;
+			if(cnt < N-1)  cnt++;
+			else  cnt = 0;
+		}
+
+	}
+
+} // deconv_mvu_nm()
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  NN,	// nonzero weights per group
+	unsigned  M,	// input channels per group
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	unsigned  D = 1,	// dilation
+	typename  TW,
+	typename  TX,
+	typename  TI,
+	typename  TO
+>
+void deconv_nm(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD*NN/M],
+	TX const (&kernel_pos)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD*NN/M],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	static_assert((0 < NN) && (NN < M), "Sparsity must keep some and drop some weights.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+	constexpr unsigned  NZ = SIMD*NN/M;
+
+	using  G = deconv_geometry<K, S, PT, PB, PL, PR, OPH, OPW, H, W, D>;
+
+	// Continuous Weight and Position Feeds, walked in lockstep
+	static hls::stream<hls::vector<hls::vector<TW, NZ>, PE>>  wgt("wgt");
+	static hls::stream<hls::vector<hls::vector<TX, NZ>, PE>>  pos("pos");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STREAM_DEPTH(pos, 2);
+	DECONV_STAGE(weights, deconv_weights<K, S, G::H_EFF, G::W_EFF, CF, SF, 0, 1, 1, D>(kernel, wgt));
+	DECONV_STAGE(weights, deconv_weights<K, S, G::H_EFF, G::W_EFF, CF, SF, 1, 1, 1, D>(kernel_pos, pos));
+
+	// Activation Processing Pipeline: swg (incl. virtual padding) -> mvu -> crop
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(dst_eff, 2);
+
+	DECONV_STAGE(swg, deconv_swg<K, S, H, W, CF, SF*B, G::PADT, G::PADB, G::PADL, G::PADR, 1, 1, D>(src, swg));
+	DECONV_STAGE(mvu, deconv_mvu_nm<K/S*K/S*SF, M, B>(wgt, pos, swg, dst_eff));
+
+	DECONV_STAGE(crop, crop<G::CROPT, G::CROPB, G::CROPL, G::CROPR, G::HO_EFF, G::WO_EFF, CO*B>(dst_eff, dst));
+
+} // deconv_nm()
+
+//===========================================================================
+// Output-Tile Blocking
+
+// deconv_asym() applies every weight beat to a single window position, so the
+// weight stream carries the full kernel once per output pixel block. Blocking
+// a TX x TY tile of window positions per weight pass makes deconv_swg() emit
+// the TY*TX windows of a tile innermost and deconv_weights() step once per
+// tile: every weight beat is reused for TX*TY consecutive activations, which
+// the MVU accumulates separately just like the images of a batch. The weight
+// stream shrinks by TX*TY at the same MVU cycle count. The line buffer grows
+// by TY-1 rows, and untile() restores the raster order of the output in a
+// double buffer of TY*S output rows.
+//
+// Window positions are extended to whole tiles by virtual zero rows and
+// columns below and right of the frame, whose outputs are cropped again.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  TX,	// output tile width in window positions
+	unsigned  TY,	// output tile height in window positions
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	unsigned  D = 1,	// dilation
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_tiled(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	static_assert((TX > 0) && (TY > 0), "Tiles must not be empty.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+
+	using  G = deconv_geometry<K, S, PT, PB, PL, PR, OPH, OPW, H, W, D>;
+	constexpr unsigned  XT = (TX - (G::W_EFF-G::KW+1)%TX)%TX;	// window columns completing the last tile
+	constexpr unsigned  YT = (TY - (G::H_EFF-G::KW+1)%TY)%TY;	// window rows completing the last tile
+	constexpr unsigned  H_EFF = G::H_EFF + YT;
+	constexpr unsigned  W_EFF = G::W_EFF + XT;
+
+#if DECONV_MVU != DECONV_MVU_FUSED
+	// Continuous Weight Feed, one beat per tile
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, deconv_weights<K, S, H_EFF, W_EFF, CF, SF, 0, TX, TY, D>(kernel, wgt));
+#endif
+
+	// Activation Processing Pipeline: swg (incl. virtual padding) -> mvu -> untile -> crop
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TO, PE>>  dst_tile("dst_tile");
+	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(dst_tile, 2);
+	DECONV_STREAM_DEPTH(dst_eff, 2);
+
+	// One weight beat serves the B images of all TX*TY windows of a tile.
+	DECONV_STAGE(swg, deconv_swg<K, S, H, W, CF, SF*B, G::PADT, G::PADB+YT, G::PADL, G::PADR+XT, TX, TY, D>(src, swg));
+#if DECONV_MVU == DECONV_MVU_FUSED
+	DECONV_STAGE(mvu, deconv_mvu_fused<K, S, H_EFF, W_EFF, CF, SF, B*TX*TY, 0, TX, TY, D>(kernel, swg, dst_tile));
+#else
+	constexpr unsigned  KK = K/S;
+	DECONV_STAGE(mvu, deconv_mvu_sel<KK*KK*SF, B*TX*TY>(wgt, swg, dst_tile));
+#endif
+	DECONV_STAGE(untile, untile<S, TX, TY, (W_EFF-G::KW+1)/TX, CF*B>(dst_tile, dst_eff));
+
+	DECONV_STAGE(crop, crop<G::CROPT, G::CROPB+S*YT, G::CROPL, G::CROPR+S*XT, G::HO_EFF+S*YT, G::WO_EFF+S*XT, CO*B>(dst_eff, dst));
+
+} // deconv_tiled()
+
+//===========================================================================
+// Multi-Head Transposed Convolution
+
+// NH transposed convolutions of the same input and geometry with independent
+// kernels and outputs, e.g. the segmentation, depth and normals heads of a
+// multi-task decoder. One deconv_swg line buffer serves all heads: its window
+// stream is broadcast to NH deconv_weights -> deconv_mvu -> crop chains, so
+// line buffer memory and input bandwidth are paid once. The heads run in
+// lockstep at the rate of a single deconv_asym().
+
+//- Window Broadcast --------------------------------------------------------
+template<
+	unsigned  NH,	// number of consumers
+	typename  T
+>
+void broadcast(
+	hls::stream<T> &src,
+	hls::stream<T> (&dst)[NH]
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	bool  full = false;
+	for(unsigned  h = 0; h < NH; h++) {
+#pragma HLS unroll
+		full |= stream_full(dst[h]);
+	}
+	if(!full && !src.empty()) {
+		auto const  x = src.read();
+		for(unsigned  h = 0; h < NH; h++) {
+#pragma HLS unroll
+			dst[h].write(x);
+		}
+	}
+
+} // broadcast()
+
+//- Head Chains ---------------------------------------------------------------
+// Instantiates the chains of heads I..NH-1, each stage with its own ID.
+template<unsigned  I, unsigned  NH>
+struct deconv_heads {
+	template<
+		typename  G,	// deconv_geometry
+		unsigned  K,
+		unsigned  S,
+		unsigned  CO,
+		unsigned  CI,
+		unsigned  B,
+		size_t    PE,
+		size_t    SIMD,
+		typename  TW,
+		typename  TI,
+		typename  TO
+	>
+	static void run(
+		TW const (&kernel)[NH][(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+		hls::stream<hls::vector<TI, SIMD>> (&win)[NH],
+		hls::stream<hls::vector<TO, PE>>   (&dst)[NH]
+	) {
+#pragma HLS inline
+		constexpr unsigned  CF = CO/PE;
+		constexpr unsigned  SF = CI/SIMD;
+
+		static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+		static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+		DECONV_STREAM_DEPTH(wgt, 2);
+		DECONV_STREAM_DEPTH(dst_eff, 2);
+
+		DECONV_STAGE(weights, deconv_weights<K, S, G::H_EFF, G::W_EFF, CF, SF, I>(kernel[I], wgt));
+		DECONV_STAGE(mvu, deconv_mvu_sel<K/S*K/S*SF, B, I>(wgt, win[I], dst_eff));
+		DECONV_STAGE(crop, crop<G::CROPT, G::CROPB, G::CROPL, G::CROPR, G::HO_EFF, G::WO_EFF, CO*B, I>(dst_eff, dst[I]));
+
+		deconv_heads<I+1, NH>::template run<G, K, S, CO, CI, B>(kernel, win, dst);
+	}
+};
+template<unsigned  NH>
+struct deconv_heads<NH, NH> {
+	template<
+		typename  G, unsigned  K, unsigned  S, unsigned  CO, unsigned  CI, unsigned  B,
+		size_t  PE, size_t  SIMD, typename  TW, typename  TI, typename  TO
+	>
+	static void run(
+		TW const (&)[NH][(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+		hls::stream<hls::vector<TI, SIMD>> (&)[NH],
+		hls::stream<hls::vector<TO, PE>>   (&)[NH]
+	) {}
+};
+
+template<
+	unsigned  NH,	// number of heads
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels per head
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv_multi(
+	TW const (&kernel)[NH][(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   (&dst)[NH]
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(NH > 0, "At least one head is required.");
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+
+	using  G = deconv_geometry<K, S, PT, PB, PL, PR, OPH, OPW, H, W>;
+
+	// Shared Window Generation
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TI, SIMD>>  win[NH];
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(win, 2);
+	DECONV_STAGE(swg, deconv_swg<K, S, H, W, CF, SF*B, G::PADT, G::PADB, G::PADL, G::PADR>(src, swg));
+	DECONV_STAGE(bcast, broadcast(swg, win));
+
+	// Per-Head Weights, MVU and Cropping
+	deconv_heads<0, NH>::template run<G, K, S, CO, CI, B>(kernel, win, dst);
+
+} // deconv_multi()
 
 #endif
@@ -0,0 +1,315 @@
+/****************************************************************************
+ * 1D transposed convolution (ConvTranspose1d), e.g. the upsampling layers of
+ * audio vocoders, as a lean alternative to deconv() on an H = 1 feature map.
+ *
+ * Output sample o = m*S + s of the full transposed convolution is
+ *
+ *   y[m*S + s] = sum_{j < KK} x[m-j] * w[j*S + s],  KK = ceil(K/S)
+ *
+ * so every window of KK consecutive input samples ending at m produces the S
+ * output samples of its phases s. Taps j*S + s >= K are virtual zeros, so
+ * that S need not divide K. The pipeline
+ *
+ *   deconv1d_swg -> deconv_mvu -> crop
+ *   deconv1d_weights ---^
+ *
+ * replays each window S*CO/PE times from a ring of KK+1 input samples, one
+ * beyond the window being loaded while the window is replayed. Unlike the
+ * line buffer of deconv_swg(), it holds no image rows, so its size does not
+ * depend on the input length. deconv1d_weights() walks the phases of the
+ * native kernel [CO/PE][K][CI/SIMD][PE][SIMD] with the same sequence for
+ * every window. Zero padding is virtual, windows fully outside the output
+ * are skipped and output padding extends the right edge with zeros.
+ *
+ * A frame takes one cycle per window beat, (M1-M0)*S*(CO/PE)*KK*(CI/SIMD)
+ * for the M1-M0 windows of deconv1d_geometry, about S*(CO/PE)*KK*(CI/SIMD)
+ * per input sample, see scripts/deconv_model.py --conv1d.
+ ***************************************************************************/
+#ifndef DECONV1D_HPP
+#define DECONV1D_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#include "deconv.hpp"
+#include "utils.hpp"
+
+//- Edge Geometry ------------------------------------------------------------
+// Windows M0 <= m < M1 cover the cropped output [PL, E) of the full
+// transposed convolution, extended by the output padding OP.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OP,	// output padding, added right of the last sample
+	unsigned  W 	// input length
+>
+struct deconv1d_geometry {
+	static constexpr unsigned  KK = (K+S-1)/S;	// input samples per window
+	static constexpr unsigned  E  = (W-1)*S + K + OP - PR;	// end of the cropped output
+	static constexpr unsigned  M0 = PL/S;
+	static constexpr unsigned  M1 = (E+S-1)/S;
+	static constexpr unsigned  CROPL = PL - S*M0;
+	static constexpr unsigned  CROPR = S*M1 - E;
+	static constexpr unsigned  WO_EFF = (M1-M0)*S;
+};
+
+//- Phase-Wise Weight Sequencer ----------------------------------------------
+// Emits, for every window, the kernel beats in the order of deconv1d_swg():
+// phase s, channel fold c, window tap t (input sample m-KK+1+t, kernel tap
+// (KK-1-t)*S + s) and SIMD fold d. Virtual taps beyond K are zero beats.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  CF,	// channel fold (CO/PE)
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	size_t    PE,
+	size_t    SIMD,
+	typename  TW
+>
+void deconv1d_weights(
+	TW const (&kernel)[CF*K*SF][PE][SIMD],
+	hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	constexpr unsigned  KK = (K+S-1)/S;
+
+	static unsigned  s = 0;
+	static unsigned  c = 0;
+	static unsigned  t = 0;
+	static unsigned  d = 0;
+	static unsigned  k = (KK-1)*S;	// kernel tap (KK-1-t)*S + s
+	static unsigned  idx = (KK-1)*S*SF;	// beat (c*K + k)*SF + d, if k < K
+#pragma HLS reset variable=s
+#pragma HLS reset variable=c
+#pragma HLS reset variable=t
+#pragma HLS reset variable=d
+#pragma HLS reset variable=k
+#pragma HLS reset variable=idx
+
+#pragma HLS array_partition variable=kernel dim=1
+	bool const  real = k < K;
+	hls::vector<hls::vector<TW, SIMD>, PE>  v;
+	for(unsigned  i = 0; i < PE; i++) {
+#pragma HLS unroll
+		for(unsigned  j = 0; j < SIMD; j++) {
+#pragma HLS unroll
+			v[i][j] = real? kernel[idx][i][j] : TW(0);
+		}
+	}
+
+	if(!stream_full(dst) && dst.write_nb(v)) {
+		if(d != SF-1) {
+			d++;
+			idx++;
+		}
+		else {
+			d = 0;
+			idx -= SF-1;
+			if(t != KK-1) {
+				t++;
+				k -= S;
+				idx -= S*SF;
+			}
+			else {
+				t = 0;
+				k += (KK-1)*S;
+				idx += (KK-1)*S*SF;
+				if(c != CF-1) {
+					c++;
+					idx += K*SF;
+				}
+				else {
+					c = 0;
+					idx -= (CF-1)*K*SF;
+					if(s != S-1) {
+						s++;
+						k++;
+						idx += SF;
+					}
+					else {
+						s = 0;
+						k -= S-1;
+						idx -= (S-1)*SF;
+					}
+				}
+			}
+		}
+	}
+
+} // deconv1d_weights()
+
+//- Shift-Register Window Generator ------------------------------------------
+template<
+	unsigned  KK,	// input samples per window
+	unsigned  S, 	// stride: output phases per window
+	unsigned  W,	// input length
+	unsigned  M0,	// first window, ending at input sample M0
+	unsigned  M1,	// end of the windows
+	unsigned  CF,	// channel fold (CO/PE)
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	typename  T		// e.g. hls::vector<TI, SIMD>
+>
+void deconv1d_swg(
+	hls::stream<T> &src,
+	hls::stream<T> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static_assert(M0 < W, "Padding must leave outputs fed by the input.");
+
+	// Ring of input samples, written cyclically: the KK samples of the
+	// window and the next one being loaded. Sample positions are relative
+	// to the frame being emitted, those of the next frame run beyond W.
+	constexpr unsigned  R = KK+1;
+	constexpr unsigned  ADV = ((signed(W + M0 + 1) - signed(M1)) % signed(R) + R) % R;
+	static T  buf[R][SF];
+#pragma HLS array_partition variable=buf dim=1 complete
+#pragma HLS dependence variable=buf inter false
+	static signed    wp = 0;	// sample being loaded
+	static unsigned  wd = 0;	// its SIMD fold
+	static unsigned  ws = 0;	// its ring slot
+#pragma HLS reset variable=wp
+#pragma HLS reset variable=wd
+#pragma HLS reset variable=ws
+
+	/*
+	// Produce output in this scheme:
+	for(unsigned  m = M0; m < M1; m++) {
+		for(unsigned  s = 0; s < S; s++) {
+			for(unsigned  cf = 0; cf < CF; cf++) {
+				for(unsigned  t = 0; t < KK; t++) {
+					for(unsigned  d = 0; d < SF; d++) {
+						emit(padded_x[m-KK+1 + t, d]);
+					}
+				}
+			}
+		}
+	}
+	*/
+	static unsigned  m  = M0;
+	static unsigned  s  = 0;
+	static unsigned  cf = 0;
+	static unsigned  t  = 0;
+	static unsigned  d  = 0;
+	static unsigned  rs = ((signed(M0+1) - signed(KK)) % signed(R) + R) % R;	// ring slot of sample m-KK+1
+#pragma HLS reset variable=m
+#pragma HLS reset variable=s
+#pragma HLS reset variable=cf
+#pragma HLS reset variable=t
+#pragma HLS reset variable=d
+#pragma HLS reset variable=rs
+
+	// Only completely loaded samples are read. The last beat of a frame
+	// also waits for the frame's remaining (cropped) samples.
+	signed   const  i = signed(m + t) - signed(KK-1);
+	bool     const  real = (0 <= i) && (i < signed(W));
+	bool     const  last = (m == M1-1) && (s == S-1) && (cf == CF-1) && (t == KK-1) && (d == SF-1);
+	unsigned const  sl = (rs+t < R)? rs+t : rs+t-R;
+	if((!real || (i < wp)) && (!last || (wp >= signed(W)))) {
+		T const  y = real? buf[sl][d] : T(0);
+		if(!stream_full(dst) && dst.write_nb(y)) {
+			if(d != SF-1)  d++;
+			else {
+				d = 0;
+				if(t != KK-1)  t++;
+				else {
+					t = 0;
+					if(cf != CF-1)  cf++;
+					else {
+						cf = 0;
+						if(s != S-1)  s++;
+						else {
+							s = 0;
+							if(m != M1-1) {
+								m++;
+								rs = (rs != R-1)? rs+1 : 0;
+							}
+							else {
+								m = M0;
+								wp -= W;
+								rs = (rs+ADV < R)? rs+ADV : rs+ADV-R;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Load into the slot of sample wp-R, which window m no longer needs.
+	// Samples right of the last window are dropped.
+	bool const  skip = (signed(M1) <= wp) && (wp < signed(W));
+	if(skip || (wp <= signed(m)+1)) {
+		T  x;
+		if(src.read_nb(x)) {
+			if(!skip)  buf[ws][wd] = x;
+			if(wd != SF-1)  wd++;
+			else {
+				wd = 0;
+				wp++;
+				ws = (ws != R-1)? ws+1 : 0;
+			}
+		}
+	}
+
+} // deconv1d_swg()
+
+//===========================================================================
+// 1D Transposed Convolution
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OP,	// output padding, added right of the last sample
+	unsigned  W,	// input length
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  B = 1,	// batch of sequences interleaved beat by beat
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void deconv1d(
+	TW const (&kernel)[(CO/PE)*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+
+	using  G = deconv1d_geometry<K, S, PL, PR, OP, W>;
+
+	// Continuous Weight Feed: the same phase sequence for every window
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, deconv1d_weights<K, S, CF, SF>(kernel, wgt));
+
+	// Activation Processing Pipeline: swg (incl. virtual padding) -> mvu -> crop
+	static hls::stream<hls::vector<TI, SIMD>>  swg("swg");
+	static hls::stream<hls::vector<TO, PE>>  dst_eff("dst_eff");
+	DECONV_STREAM_DEPTH(swg, 2);
+	DECONV_STREAM_DEPTH(dst_eff, 2);
+
+	DECONV_STAGE(swg, deconv1d_swg<G::KK, S, W, G::M0, G::M1, CF, SF*B>(src, swg));
+	DECONV_STAGE(mvu, deconv_mvu_sel<G::KK*SF, B>(wgt, swg, dst_eff));
+
+	DECONV_STAGE(crop, crop<0, 0, G::CROPL, G::CROPR, 1, G::WO_EFF, CO*B>(dst_eff, dst));
+
+} // deconv1d()
+
+#endif
@@ -0,0 +1,259 @@
+/****************************************************************************
+ * Verilator AXI-Stream driver for the RTL exported from a deconv_top solution.
+ *
+ * Streams the input tensor of a benchmark configuration (NCHW CSV as written
+ * by deconv_benchmark.py) into `src`, collects `dst` and checks it against the
+ * golden HWC output CSV. Several frames are streamed back to back while `dst`
+ * backpressure and `src` bubbles are injected randomly, so that cycles per
+ * frame and stall behaviour can be measured without Vitis.
+ *
+ * Configuration is passed as preprocessor definitions (see
+ * scripts/verilator_sim.sh): K, S, H, W, CI, CO, P, PE, SIMD, TI_BITS, TO_BITS
+ * DECONV_RST_ACTIVE_LOW and DECONV_BATCH. A batch-interleaved design receives
+ * every input beat once per image and must return every output beat likewise.
+ *
+ * Usage: Vdeconv_top <input.csv> <golden_output.csv> [frames] [ready%] [valid%] [seed]
+ ***************************************************************************/
+#include "Vdeconv_top.h"
+#include "verilated.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef TI_BITS
+#define TI_BITS 4
+#endif
+#ifndef TO_BITS
+#define TO_BITS 16
+#endif
+#ifndef DECONV_RST_ACTIVE_LOW
+#define DECONV_RST_ACTIVE_LOW 1
+#endif
+#ifndef DECONV_BATCH
+#define DECONV_BATCH 1
+#endif
+
+//- Bit Access to Verilated Signals ------------------------------------------
+template <typename T>
+static void set_bits(T &sig, unsigned lsb, unsigned width, uint64_t val) {
+  uint64_t const mask = ((uint64_t(1) << width) - 1) << lsb;
+  sig = T((uint64_t(sig) & ~mask) | ((val << lsb) & mask));
+}
+template <std::size_t N>
+static void set_bits(VlWide<N> &sig, unsigned lsb, unsigned width,
+                     uint64_t val) {
+  for (unsigned i = 0; i < width; i++) {
+    unsigned const b = lsb + i;
+    uint32_t const m = uint32_t(1) << (b % 32);
+    if ((val >> i) & 1)
+      sig[b / 32] |= m;
+    else
+      sig[b / 32] &= ~m;
+  }
+}
+
+template <typename T>
+static uint64_t get_bits(T const &sig, unsigned lsb, unsigned width) {
+  return (uint64_t(sig) >> lsb) & ((uint64_t(1) << width) - 1);
+}
+template <std::size_t N>
+static uint64_t get_bits(VlWide<N> const &sig, unsigned lsb, unsigned width) {
+  uint64_t val = 0;
+  for (unsigned i = 0; i < width; i++) {
+    unsigned const b = lsb + i;
+    val |= uint64_t((sig[b / 32] >> (b % 32)) & 1) << i;
+  }
+  return val;
+}
+
+static std::vector<uint64_t> load_csv(std::string const &path) {
+  std::vector<uint64_t> values;
+  std::ifstream ifs(path);
+  std::string tok;
+  while (std::getline(ifs, tok, '\n')) {
+    size_t pos = 0;
+    while (pos < tok.size()) {
+      size_t const end = tok.find(',', pos);
+      std::string const v = tok.substr(pos, end - pos);
+      if (!v.empty())
+        values.push_back(uint64_t(std::stoll(v)));
+      if (end == std::string::npos)
+        break;
+      pos = end + 1;
+    }
+  }
+  return values;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0]
+              << " <input.csv> <golden_output.csv> [frames] [ready%] [valid%] "
+                 "[seed]\n";
+    return 2;
+  }
+  unsigned const frames = argc > 3 ? unsigned(std::atoi(argv[3])) : 4;
+  unsigned const ready_pct = argc > 4 ? unsigned(std::atoi(argv[4])) : 100;
+  unsigned const valid_pct = argc > 5 ? unsigned(std::atoi(argv[5])) : 100;
+  unsigned const seed = argc > 6 ? unsigned(std::atoi(argv[6])) : 1;
+
+  // Input: NCHW -> stream order (h, w, channel fold, image, SIMD lane)
+  std::vector<uint64_t> const input = load_csv(argv[1]);
+  std::vector<uint64_t> const golden = load_csv(argv[2]);
+  if (input.size() != size_t(CI) * H * W) {
+    std::cerr << "Input tensor has " << input.size() << " values, expected "
+              << CI * H * W << '\n';
+    return 2;
+  }
+  if (golden.size() % CO != 0) {
+    std::cerr << "Golden output size is not a multiple of CO\n";
+    return 2;
+  }
+  std::vector<std::vector<uint64_t>> in_beats;
+  for (unsigned h = 0; h < H; h++) {
+    for (unsigned w = 0; w < W; w++) {
+      for (unsigned sf = 0; sf < CI / SIMD; sf++) {
+        std::vector<uint64_t> beat(SIMD);
+        for (unsigned i = 0; i < SIMD; i++)
+          beat[i] = input[(sf * SIMD + i) * H * W + h * W + w];
+        for (unsigned b = 0; b < DECONV_BATCH; b++)
+          in_beats.push_back(beat);
+      }
+    }
+  }
+  size_t const out_beats_per_frame = golden.size() / PE * DECONV_BATCH;
+
+  auto ctx = std::make_unique<VerilatedContext>();
+  ctx->commandArgs(argc, argv);
+  auto top = std::make_unique<Vdeconv_top>(ctx.get());
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<unsigned> pct(0, 99);
+
+  auto tick = [&]() {
+    top->ap_clk = 0;
+    top->eval();
+    top->ap_clk = 1;
+    top->eval();
+    ctx->timeInc(1);
+  };
+
+  // Reset
+#if DECONV_RST_ACTIVE_LOW
+  top->ap_rst_n = 0;
+#else
+  top->ap_rst = 1;
+#endif
+  top->src_TVALID = 0;
+  top->dst_TREADY = 0;
+  for (unsigned i = 0; i < 16; i++)
+    tick();
+#if DECONV_RST_ACTIVE_LOW
+  top->ap_rst_n = 1;
+#else
+  top->ap_rst = 0;
+#endif
+
+  uint64_t cycle = 0;
+  uint64_t src_stalls = 0; // cycles with src_TVALID but !src_TREADY
+  uint64_t dst_stalls = 0; // cycles with dst_TREADY withheld by the driver
+  size_t in_idx = 0;
+  size_t out_idx = 0;
+  size_t const in_total = in_beats.size() * frames;
+  size_t const out_total = out_beats_per_frame * frames;
+  std::vector<uint64_t> frame_done(frames, 0);
+  uint64_t first_in = 0;
+  unsigned errors = 0;
+  uint64_t const timeout = 1000 + 64 * (uint64_t(K) * K * CO * CI + 1) *
+                                      (H + 2 * K) * (W + 2 * K) * frames *
+                           DECONV_BATCH;
+
+  auto const t0 = std::chrono::steady_clock::now();
+  while ((out_idx < out_total) && (cycle < timeout)) {
+    // Drive inputs for this cycle
+    bool const offer = (in_idx < in_total) && (pct(rng) < valid_pct);
+    top->src_TVALID = offer;
+    if (offer) {
+      auto const &beat = in_beats[in_idx % in_beats.size()];
+      for (unsigned i = 0; i < SIMD; i++)
+        set_bits(top->src_TDATA, i * TI_BITS, TI_BITS, beat[i]);
+    }
+    bool const ready = pct(rng) < ready_pct;
+    top->dst_TREADY = ready;
+    if (!ready)
+      dst_stalls++;
+
+    // Sample handshakes before the rising edge
+    top->ap_clk = 0;
+    top->eval();
+    bool const src_fire = offer && top->src_TREADY;
+    bool const dst_fire = ready && top->dst_TVALID;
+    if (offer && !top->src_TREADY)
+      src_stalls++;
+    if (dst_fire) {
+      for (unsigned pe = 0; pe < PE; pe++) {
+        uint64_t const y = get_bits(top->dst_TDATA, pe * TO_BITS, TO_BITS);
+        size_t const g =
+            (out_idx % out_beats_per_frame) / DECONV_BATCH * PE + pe;
+        uint64_t const expected =
+            golden[g] & ((uint64_t(1) << TO_BITS) - 1);
+        if (y != expected) {
+          if (errors < 10)
+            std::cerr << "Mismatch frame " << out_idx / out_beats_per_frame
+                      << " element " << g << ": got " << y << ", expected "
+                      << expected << '\n';
+          errors++;
+        }
+      }
+    }
+    top->ap_clk = 1;
+    top->eval();
+    ctx->timeInc(1);
+
+    if (src_fire) {
+      if (in_idx == 0)
+        first_in = cycle;
+      in_idx++;
+    }
+    if (dst_fire) {
+      out_idx++;
+      if (out_idx % out_beats_per_frame == 0)
+        frame_done[out_idx / out_beats_per_frame - 1] = cycle;
+    }
+    cycle++;
+  }
+  auto const t1 = std::chrono::steady_clock::now();
+  double const secs = std::chrono::duration<double>(t1 - t0).count();
+  top->final();
+
+  if (out_idx < out_total) {
+    std::cerr << "TIMEOUT after " << cycle << " cycles: " << out_idx << " of "
+              << out_total << " output beats\n";
+    return 1;
+  }
+
+  std::cout << "frames=" << frames << " in_beats/frame=" << in_beats.size()
+            << " out_beats/frame=" << out_beats_per_frame << '\n';
+  std::cout << "first_frame_latency=" << frame_done[0] - first_in << '\n';
+  for (unsigned f = 1; f < frames; f++)
+    std::cout << "frame" << f
+              << "_cycles=" << frame_done[f] - frame_done[f - 1] << '\n';
+  if (frames > 1)
+    std::cout << "cycles_per_frame="
+              << double(frame_done[frames - 1] - frame_done[0]) / (frames - 1)
+              << '\n';
+  std::cout << "src_stall_cycles=" << src_stalls
+            << " dst_backpressure_cycles=" << dst_stalls << '\n';
+  std::cout << "sim_cycles=" << cycle << " wall_s=" << secs
+            << " mcycles_per_s=" << (secs > 0 ? cycle / secs / 1e6 : 0.0)
+            << '\n';
+  std::cout << (errors == 0 ? "PASS" : "FAIL") << " errors=" << errors
+            << '\n';
+  return errors == 0 ? 0 : 1;
+}
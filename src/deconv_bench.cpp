@@ -0,0 +1,353 @@
+/****************************************************************************
+ * Host benchmark harness for the C simulation model of deconv<>.
+ *
+ * Streams frames through deconv_top() of the configuration in deconv_top.hpp
+ * (deconv<>, or the engine it selects, and the output encoder) and brackets
+ * every run (and optionally every pipeline stage) with Linux perf_event
+ * hardware counters: cycles, instructions, cache misses and branch misses.
+ * Results are written as JSON, including counters per output pixel.
+ *
+ * Stage attribution hooks into the DECONV_STAGE() macro of utils.hpp, which
+ * is a plain call everywhere else; deconv_top.cpp is included after defining
+ * it rather than linked. Enabling and disabling the counter group around
+ * every stage invocation costs two ioctl()s per call; kernel time is
+ * excluded, but expect the per-stage numbers to carry that fixed overhead.
+ *
+ * Usage: deconv_bench [--runs N] [--frames F] [--stages] [--json FILE]
+ ***************************************************************************/
+#include "deconv_top.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//- Hardware Counter Group ---------------------------------------------------
+class PerfGroup {
+public:
+  static constexpr unsigned N = 4;
+  static char const *name(unsigned i) {
+    static char const *const names[N] = {"cycles", "instructions",
+                                         "cache_misses", "branch_misses"};
+    return names[i];
+  }
+
+private:
+  int fd[N];
+  bool ok;
+
+public:
+  PerfGroup() : ok(true) {
+    static uint64_t const configs[N] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (unsigned i = 0; i < N; i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[i];
+      attr.disabled = (i == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      fd[i] = int(syscall(__NR_perf_event_open, &attr, 0, -1,
+                          i == 0 ? -1 : fd[0], 0));
+      if (fd[i] < 0)
+        ok = false;
+    }
+    static bool warned = false;
+    if (!ok && !warned) {
+      warned = true;
+      std::cerr << "perf_event_open failed (" << std::strerror(errno)
+                << "); reporting wall time only. Check "
+                   "/proc/sys/kernel/perf_event_paranoid.\n";
+    }
+  }
+  ~PerfGroup() {
+    for (unsigned i = 0; i < N; i++)
+      if (fd[i] >= 0)
+        close(fd[i]);
+  }
+  bool valid() const { return ok; }
+
+  void enable() {
+    if (ok)
+      ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  void disable() {
+    if (ok)
+      ioctl(fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  }
+  void reset() {
+    if (ok)
+      ioctl(fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  }
+  void read(uint64_t (&val)[N]) {
+    uint64_t buf[1 + N] = {0};
+    if (ok && (::read(fd[0], buf, sizeof(buf)) != ssize_t(sizeof(buf))))
+      ok = false;
+    for (unsigned i = 0; i < N; i++)
+      val[i] = buf[1 + i];
+  }
+};
+
+//- Stage Attribution --------------------------------------------------------
+// Stages not part of the configured engine are left out of the report
+enum Stage {
+  STAGE_weights,
+  STAGE_resize,
+  STAGE_swg,
+  STAGE_bcast,
+  STAGE_mvu,
+  STAGE_untile,
+  STAGE_d2s,
+  STAGE_replay,
+  STAGE_col2im,
+  STAGE_crop,
+  STAGE_encode,
+  STAGE_COUNT
+};
+static char const *const STAGE_NAMES[STAGE_COUNT] = {
+    "weights", "resize", "swg",    "bcast", "mvu",   "untile",
+    "d2s",     "replay", "col2im", "crop",  "encode"};
+
+static PerfGroup *stage_perf = nullptr;
+static uint64_t stage_counts[STAGE_COUNT][PerfGroup::N];
+static uint64_t stage_calls[STAGE_COUNT];
+
+static void stage_begin(Stage) {
+  if (stage_perf) {
+    stage_perf->reset();
+    stage_perf->enable();
+  }
+}
+static void stage_end(Stage s) {
+  if (stage_perf) {
+    stage_perf->disable();
+    uint64_t v[PerfGroup::N];
+    stage_perf->read(v);
+    for (unsigned i = 0; i < PerfGroup::N; i++)
+      stage_counts[s][i] += v[i];
+    stage_calls[s]++;
+  }
+}
+
+#define DECONV_STAGE(name, ...)                                                \
+  do {                                                                         \
+    stage_begin(STAGE_##name);                                                 \
+    __VA_ARGS__;                                                               \
+    stage_end(STAGE_##name);                                                   \
+  } while (0)
+// deconv_top() built with the stage hook above
+#include "deconv_top.cpp"
+#include "deconv_top_frame.hpp"
+
+//- Benchmark ----------------------------------------------------------------
+int main(int argc, char **argv) {
+  unsigned runs = 5;
+  unsigned frames = 1;
+  bool stages = false;
+  std::string json_path;
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if ((arg == "--runs") && (i + 1 < argc))
+      runs = unsigned(std::atoi(argv[++i]));
+    else if ((arg == "--frames") && (i + 1 < argc))
+      frames = unsigned(std::atoi(argv[++i]));
+    else if (arg == "--stages")
+      stages = true;
+    else if ((arg == "--json") && (i + 1 < argc))
+      json_path = argv[++i];
+    else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--runs N] [--frames F] [--stages] [--json FILE]\n";
+      return 2;
+    }
+  }
+
+  using F = deconv_top_frame;
+  // A frame is a batch of DECONV_BATCH images interleaved beat by beat
+  constexpr uint64_t OUT_BEATS = F::OUT_BEATS;
+  constexpr uint64_t IN_BEATS = F::IN_BEATS;
+  constexpr unsigned HO = F::HO;
+  constexpr unsigned WO = F::WO;
+
+  PerfGroup run_perf;
+  PerfGroup stage_group;
+  if (stages && stage_group.valid())
+    stage_perf = &stage_group;
+
+  std::vector<std::vector<uint64_t>> results;
+  std::vector<double> wall_ns;
+  uint64_t ticks_total = 0;
+  uint64_t encoded_total = 0; // dst beats, fewer than decoded when encoded
+  for (unsigned r = 0; r < runs; r++) {
+    hls::stream<hls::vector<TI, SIMD>> src;
+    hls::stream<hls::vector<TO, PE>> dst;
+    output_decoder<OUT_BEATS, F::CB, DECONV_ENCODE_GROUP, DECONV_ENCODE, PE,
+                   TO>
+        decoder;
+    std::vector<hls::vector<TO, PE>> decoded;
+    for (unsigned f = 0; f < frames; f++)
+      for (uint64_t i = 0; i < IN_BEATS; i++)
+        src.write(TI(i));
+
+    uint64_t received = 0;
+    uint64_t ticks = 0;
+    uint64_t const tick_limit = 64 * (OUT_BEATS * K * K * CI + 1024) * frames;
+    run_perf.reset();
+    auto const t0 = std::chrono::steady_clock::now();
+    run_perf.enable();
+    while ((received < OUT_BEATS * frames) && (ticks < tick_limit)) {
+      deconv_top(src, dst);
+      while (!dst.empty()) {
+        decoded.clear();
+        decoder.push(dst.read(), decoded);
+        received += decoded.size();
+        encoded_total++;
+      }
+      ticks++;
+    }
+    run_perf.disable();
+    auto const t1 = std::chrono::steady_clock::now();
+    if (received < OUT_BEATS * frames) {
+      std::cerr << "Run " << r << " stalled after " << ticks << " calls ("
+                << received << " of " << OUT_BEATS * frames << " beats)\n";
+      return 1;
+    }
+
+    uint64_t v[PerfGroup::N];
+    run_perf.read(v);
+    results.emplace_back(v, v + PerfGroup::N);
+    wall_ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    ticks_total += ticks;
+  }
+
+  // JSON Report
+  double const pixels = double(HO) * WO * frames * DECONV_BATCH;
+  std::string json;
+  char buf[256];
+  bool const valid = run_perf.valid();
+  auto emit_counters = [&](uint64_t const *v, double per) {
+    for (unsigned i = 0; i < PerfGroup::N; i++) {
+      if (valid)
+        std::snprintf(buf, sizeof(buf), "%s\"%s\": %llu", i ? ", " : "",
+                      PerfGroup::name(i), (unsigned long long)v[i]);
+      else
+        std::snprintf(buf, sizeof(buf), "%s\"%s\": null", i ? ", " : "",
+                      PerfGroup::name(i));
+      json += buf;
+    }
+    json += ", \"per_output_pixel\": {";
+    for (unsigned i = 0; i < PerfGroup::N; i++) {
+      if (valid)
+        std::snprintf(buf, sizeof(buf), "%s\"%s\": %.3f", i ? ", " : "",
+                      PerfGroup::name(i), v[i] / per);
+      else
+        std::snprintf(buf, sizeof(buf), "%s\"%s\": null", i ? ", " : "",
+                      PerfGroup::name(i));
+      json += buf;
+    }
+    json += "}";
+  };
+
+#ifdef DECONV_RESIZE_CONV
+  char const *const engine =
+      (RESIZE == RESIZE_BILINEAR) ? "resize_bilinear" : "resize_nearest";
+#elif defined(DECONV_DEPTH_TO_SPACE)
+  char const *const engine = "deconv_d2s";
+#elif defined(DECONV_MM2IM)
+  char const *const engine = "mm2im";
+#elif defined(DECONV_1D)
+  char const *const engine = "deconv1d";
+#elif defined(DECONV_NM_SPARSE)
+  char const *const engine = "deconv_nm";
+#elif (DECONV_TILE_X > 1) || (DECONV_TILE_Y > 1)
+  char const *const engine = "deconv_tiled";
+#else
+  char const *const engine = "deconv";
+#endif
+#if DECONV_MVU == DECONV_MVU_SYSTOLIC
+  char const *const mvu = "systolic";
+#elif DECONV_MVU == DECONV_MVU_CASCADE
+  char const *const mvu = "cascade";
+#elif DECONV_MVU == DECONV_MVU_FUSED
+  char const *const mvu = "fused";
+#else
+  char const *const mvu = "broadcast";
+#endif
+#if DECONV_ENCODE == DECONV_ENCODE_BITMAP
+  char const *const encode = "bitmap";
+#elif DECONV_ENCODE == DECONV_ENCODE_DELTA
+  char const *const encode = "delta";
+#else
+  char const *const encode = "none";
+#endif
+  std::snprintf(buf, sizeof(buf),
+                "{\n  \"engine\": \"%s\", \"mvu\": \"%s\", "
+                "\"encode\": \"%s\",\n"
+                "  \"config\": {\"K\": %u, \"S\": %u, \"D\": %u, \"P\": %u, "
+                "\"H\": %u, \"W\": %u, \"CI\": %u, \"CO\": %u, \"PE\": %u, "
+                "\"SIMD\": %u, \"B\": %u, \"TX\": %u, \"TY\": %u},\n",
+                engine, mvu, encode, K, S, D, P, H, W, CI, CO, PE, SIMD,
+                DECONV_BATCH, DECONV_TILE_X, DECONV_TILE_Y);
+  json += buf;
+  std::snprintf(buf, sizeof(buf),
+                "  \"frames\": %u, \"output_pixels_per_frame\": %u, "
+                "\"calls_per_run\": %.1f, \"counters_valid\": %s,\n",
+                frames, HO * WO, double(ticks_total) / runs,
+                valid ? "true" : "false");
+  json += buf;
+  // Output beats as sent towards DDR, relative to the raw stream
+  std::snprintf(buf, sizeof(buf),
+                "  \"dst_beats_per_frame\": %.1f, \"dst_ratio\": %.4f,\n",
+                double(encoded_total) / runs / frames,
+                double(encoded_total) / (double(OUT_BEATS) * frames * runs));
+  json += buf;
+  json += "  \"runs\": [\n";
+  for (unsigned r = 0; r < runs; r++) {
+    std::snprintf(buf, sizeof(buf), "    {\"wall_ns\": %.0f, \"wall_ns_per_output_pixel\": %.3f, ",
+                  wall_ns[r], wall_ns[r] / pixels);
+    json += buf;
+    emit_counters(results[r].data(), pixels);
+    json += (r + 1 < runs) ? "},\n" : "}\n";
+  }
+  json += "  ]";
+  if (stage_perf) {
+    json += ",\n  \"stages\": {";
+    char const *sep = "\n";
+    for (unsigned s = 0; s < STAGE_COUNT; s++) {
+      if (stage_calls[s] == 0)
+        continue;
+      std::snprintf(buf, sizeof(buf), "%s    \"%s\": {\"calls\": %llu, ", sep,
+                    STAGE_NAMES[s], (unsigned long long)stage_calls[s]);
+      json += buf;
+      emit_counters(stage_counts[s], pixels * runs);
+      json += "}";
+      sep = ",\n";
+    }
+    json += "\n  }";
+  }
+  json += "\n}\n";
+
+  if (json_path.empty())
+    std::cout << json;
+  else {
+    std::ofstream ofs(json_path);
+    ofs << json;
+    std::cout << "Benchmark results written to " << json_path << std::endl;
+  }
+  return 0;
+}
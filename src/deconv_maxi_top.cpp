@@ -0,0 +1,77 @@
+/****************************************************************************
+ * Memory-mapped frame movers around deconv_top().
+ *
+ * deconv_maxi_read() and deconv_maxi_write() replace the external DMA of the
+ * AXI-Stream top. They are kernels of their own, linked to the src and dst
+ * ports of the free-running (ap_ctrl_none) deconv_top() kernel:
+ *
+ *   DDR -> deconv_maxi_read() -> deconv_top() -> deconv_maxi_write() -> DDR
+ *
+ * The host programs the base address, the frame stride and the frame count
+ * of each mover once through its s_axilite `control` bundle. Every launch is
+ * then a write of ap_start to both movers, and ap_done of deconv_maxi_write()
+ * rises once the last output frame has reached DDR. The engine runs on its
+ * own and carries its state over from one launch to the next, so
+ * back-to-back launches keep it busy.
+ *
+ * Input frame f is read from src[f*src_stride] on as the H*W*(CI/SIMD)*B
+ * beats of the src stream of deconv_top(). Output frame f is written to
+ * dst[f*dst_stride] on as the HO*WO*(CO/PE)*B beats of its dst stream.
+ * Strides count beats and must be at least the frame size. Each frame is a
+ * linear sequence of bursts of up to DECONV_MAXI_BURST beats with up to
+ * DECONV_MAXI_OUTSTANDING transactions in flight.
+ ***************************************************************************/
+#include "deconv_maxi_top.hpp"
+#include "deconv_top_frame.hpp"
+#include "utils.hpp"
+
+//===========================================================================
+// Burst Reader: DDR -> src of deconv_top()
+void deconv_maxi_read(
+	hls::vector<TI, SIMD> const *src,	// input frames
+	unsigned  src_stride,	// beats from one input frame to the next
+	unsigned  frames,	// frames per launch
+	hls::stream<hls::vector<TI, SIMD>> &dst	// to the src port of deconv_top()
+) {
+#pragma HLS interface m_axi port=src bundle=gmem offset=slave max_read_burst_length=DECONV_MAXI_BURST num_read_outstanding=DECONV_MAXI_OUTSTANDING
+#pragma HLS interface s_axilite port=src bundle=control
+#pragma HLS interface s_axilite port=src_stride bundle=control
+#pragma HLS interface s_axilite port=frames bundle=control
+#pragma HLS interface s_axilite port=return bundle=control
+#pragma HLS interface axis port=dst
+
+	for(unsigned  f = 0; f < frames; f++) {
+		hls::vector<TI, SIMD> const *const  frame = src + size_t(f)*src_stride;
+		for(unsigned  i = 0; i < deconv_top_frame::IN_BEATS; i++) {
+#pragma HLS pipeline II=1
+			dst.write(frame[i]);
+		}
+	}
+
+} // deconv_maxi_read()
+
+//===========================================================================
+// Burst Writer: dst of deconv_top() -> DDR
+void deconv_maxi_write(
+	hls::stream<hls::vector<TO, PE>> &src,	// from the dst port of deconv_top()
+	hls::vector<TO, PE> *dst,	// output frames
+	unsigned  dst_stride,	// beats from one output frame to the next
+	unsigned  frames	// frames per launch
+) {
+#pragma HLS interface axis port=src
+#pragma HLS interface m_axi port=dst bundle=gmem offset=slave max_write_burst_length=DECONV_MAXI_BURST num_write_outstanding=DECONV_MAXI_OUTSTANDING
+#pragma HLS interface s_axilite port=dst bundle=control
+#pragma HLS interface s_axilite port=dst_stride bundle=control
+#pragma HLS interface s_axilite port=frames bundle=control
+#pragma HLS interface s_axilite port=return bundle=control
+	static_assert(DECONV_ENCODE == DECONV_ENCODE_NONE, "Encoded frames have no fixed size in DDR.");
+
+	for(unsigned  f = 0; f < frames; f++) {
+		hls::vector<TO, PE> *const  frame = dst + size_t(f)*dst_stride;
+		for(unsigned  i = 0; i < deconv_top_frame::OUT_BEATS; i++) {
+#pragma HLS pipeline II=1
+			frame[i] = src.read();
+		}
+	}
+
+} // deconv_maxi_write()
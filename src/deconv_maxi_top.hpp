@@ -0,0 +1,19 @@
+#ifndef DECONV_MAXI_TOP_HPP
+#define DECONV_MAXI_TOP_HPP
+
+#include "deconv_top.hpp"
+
+void deconv_maxi_read(
+	hls::vector<TI, SIMD> const *src,
+	unsigned  src_stride,
+	unsigned  frames,
+	hls::stream<hls::vector<TI, SIMD>> &dst
+);
+void deconv_maxi_write(
+	hls::stream<hls::vector<TO, PE>> &src,
+	hls::vector<TO, PE> *dst,
+	unsigned  dst_stride,
+	unsigned  frames
+);
+
+#endif
@@ -0,0 +1,505 @@
+/****************************************************************************
+ * Priority-aware multi-stream scheduler for one deconv accelerator.
+ *
+ * Several input streams (e.g. cameras) share the engine of the configuration
+ * in deconv_top.hpp. The Scheduler class keeps a frame queue per stream:
+ * the host submit()s frames as they arrive, and dispatch() starts the next
+ * one whenever the backend can take its input. It picks the stream by policy
+ * and dispatches a whole frame (DECONV_BATCH frames of that stream with a
+ * batch-interleaved design):
+ *
+ *   priority  highest (aged) priority, then earliest deadline, then arrival
+ *   edf       earliest deadline, then arrival
+ *   fifo      arrival order across all streams
+ *
+ * Dispatch is non-preemptive at frame granularity. With --aging-us A a
+ * waiting frame gains one priority level per A microseconds, so bulk streams
+ * are delayed but never starved by saturating real-time ones.
+ *
+ * Time is kept in accelerator cycles at --fmax. The emulated backend steps
+ * the C model of deconv_top() once per cycle. A dispatch completes with its
+ * last output beat, and the next one is fed as soon as the engine has taken
+ * the input of the previous one, so back-to-back frames overlap as on the
+ * free-running device. It is built together with deconv_top.cpp, like the
+ * testbench. Another backend (e.g. a device driver) only has to implement
+ * Backend::ready(), start() and step().
+ *
+ * main() drives the scheduler with periodic arrivals per stream.
+ *
+ * Per stream, the report lists queueing delay (arrival to dispatch) and
+ * latency (arrival to completion) percentiles and the deadline misses.
+ *
+ * Stream spec: name:priority:period[:deadline[:burst]]
+ *   period and deadline are microseconds, or multiples of the measured frame
+ *   service time with an 'f' suffix (e.g. 2.5f); deadline 0 means none, and
+ *   burst frames arrive together every period (default 1).
+ *
+ * Usage: deconv_sched --stream SPEC [--stream SPEC ...] [--policy P]
+ *          [--duration-ms T] [--fmax MHz] [--aging-us A] [--json FILE]
+ ***************************************************************************/
+#include "deconv_top.hpp"
+#include "deconv_top_frame.hpp"
+#include "utils.hpp"
+#include "output_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//- Backends -----------------------------------------------------------------
+// A backend is stepped one accelerator cycle at a time. Dispatches are
+// processed in the order they are started; a new one may start as soon as the
+// device has taken the input of the previous ones, so that it overlaps with
+// their computation and output as on the free-running engine.
+class Backend {
+public:
+  virtual ~Backend() {}
+  virtual char const *name() const = 0;
+  // Whether start() is accepted: no input of earlier dispatches is pending.
+  virtual bool ready() const = 0;
+  // Starts one dispatch (DECONV_BATCH images) behind those in flight.
+  virtual void start(unsigned stream, uint64_t frame) = 0;
+  // Advances by one cycle, returns the number of dispatches completed in it.
+  virtual unsigned step() = 0;
+};
+
+class EmulatedBackend : public Backend {
+  static constexpr uint64_t IN_BEATS = deconv_top_frame::IN_BEATS;
+  static constexpr uint64_t OUT_BEATS = deconv_top_frame::OUT_BEATS;
+
+  hls::stream<hls::vector<TI, SIMD>> src;
+  hls::stream<hls::vector<TO, PE>> dst;
+  output_decoder<OUT_BEATS, deconv_top_frame::CB, DECONV_ENCODE_GROUP,
+                 DECONV_ENCODE, PE, TO>
+      decoder;
+  std::vector<hls::vector<TO, PE>> decoded;
+
+  std::deque<TI> input;   // beats of started dispatches not yet fed to src
+  unsigned inflight = 0;  // started dispatches not yet completed
+  uint64_t received = 0;  // output beats of the oldest one in flight
+  uint64_t idle = 0;      // cycles in flight without an output beat
+
+public:
+  EmulatedBackend() { stream_depth(src, DECONV_CSIM_PORT_DEPTH); }
+
+  char const *name() const override { return "emulated"; }
+
+  bool ready() const override { return input.empty() && src.empty(); }
+
+  void start(unsigned stream, uint64_t frame) override {
+    for (uint64_t i = 0; i < IN_BEATS; i++)
+      input.push_back(TI(stream + frame + i));
+    inflight++;
+  }
+
+  unsigned step() override {
+    while (!input.empty() && !stream_full(src)) {
+      src.write(input.front());
+      input.pop_front();
+    }
+    deconv_top(src, dst);
+
+    unsigned done = 0;
+    uint64_t beats = 0;
+    while (!dst.empty()) {
+      decoded.clear();
+      decoder.push(dst.read(), decoded);
+      beats += decoded.size();
+    }
+    received += beats;
+    while ((inflight > 0) && (received >= OUT_BEATS)) {
+      received -= OUT_BEATS;
+      inflight--;
+      done++;
+    }
+
+    // Rows cropped between frames produce no output for a while
+    uint64_t const limit = 64 * (OUT_BEATS * K * K * CI + 1024);
+    idle = (beats || !inflight) ? 0 : idle + 1;
+    if (idle >= limit) {
+      std::cerr << "Emulated backend stalled with " << inflight
+                << " dispatches in flight (" << received << " of "
+                << OUT_BEATS << " beats)\n";
+      std::exit(1);
+    }
+    return done;
+  }
+};
+
+//- Scheduler ----------------------------------------------------------------
+// Per-stream frame queues in front of one backend. The host submit()s frames
+// as they arrive and calls dispatch() whenever it may start work; advance()
+// steps the backend and retires the dispatches it completes.
+class Scheduler {
+public:
+  enum Policy { PRIORITY, EDF, FIFO };
+
+  struct Stats {
+    std::vector<uint64_t> queue_delay; // arrival to dispatch
+    std::vector<uint64_t> latency;     // arrival to completion
+    uint64_t misses = 0;
+  };
+
+  Scheduler(Backend &backend, Policy policy, uint64_t aging)
+      : backend(backend), policy(policy), aging(aging) {}
+
+  // Adds a stream, returns its index for submit()
+  unsigned add_stream(int priority) {
+    streams.emplace_back();
+    streams.back().priority = priority;
+    return unsigned(streams.size() - 1);
+  }
+
+  // Queues a frame of stream s arriving at cycle `arrival`, due by the
+  // absolute cycle `deadline` (UINT64_MAX if none).
+  void submit(unsigned s, uint64_t arrival, uint64_t deadline) {
+    Stream &st = streams[s];
+    st.queue.push_back(Frame{st.submitted++, arrival, deadline});
+  }
+
+  // Starts up to DECONV_BATCH queued frames of the stream chosen by policy if
+  // the backend accepts a dispatch. Returns whether it did.
+  bool dispatch(uint64_t now) {
+    if (!backend.ready())
+      return false;
+    int pick = -1;
+    for (unsigned s = 0; s < streams.size(); s++)
+      if (!streams[s].queue.empty() &&
+          ((pick < 0) || before(s, unsigned(pick), now)))
+        pick = int(s);
+    if (pick < 0)
+      return false;
+
+    Stream &st = streams[unsigned(pick)];
+    Dispatch d{unsigned(pick), now, {}};
+    while (!st.queue.empty() && (d.frames.size() < DECONV_BATCH)) {
+      d.frames.push_back(st.queue.front());
+      st.queue.pop_front();
+    }
+    backend.start(d.stream, d.frames[0].index);
+    inflight.push_back(d);
+    dispatched++;
+    return true;
+  }
+
+  // Steps the backend through cycle `now` and retires the dispatches that
+  // complete in it.
+  void advance(uint64_t now) {
+    if (!inflight.empty())
+      busy_total++;
+    for (unsigned n = backend.step(); n > 0; n--) {
+      Dispatch const &d = inflight.front();
+      Stats &st = streams[d.stream].stats;
+      for (auto const &f : d.frames) {
+        st.queue_delay.push_back(d.start - f.arrival);
+        st.latency.push_back(now + 1 - f.arrival);
+        if (now + 1 > f.deadline)
+          st.misses++;
+      }
+      inflight.pop_front();
+    }
+  }
+
+  bool busy() const { return !inflight.empty(); }
+  Stats const &stats(unsigned s) const { return streams[s].stats; }
+  uint64_t dispatches() const { return dispatched; }
+  uint64_t busy_cycles() const { return busy_total; }
+
+private:
+  struct Frame {
+    uint64_t index;
+    uint64_t arrival;  // cycle
+    uint64_t deadline; // absolute cycle, UINT64_MAX if none
+  };
+  struct Stream {
+    int priority = 0;
+    uint64_t submitted = 0;
+    std::deque<Frame> queue;
+    Stats stats;
+  };
+  struct Dispatch {
+    unsigned stream;
+    uint64_t start;
+    std::vector<Frame> frames;
+  };
+
+  // Selection: true if the head of stream a goes before the head of b
+  bool before(unsigned a, unsigned b, uint64_t now) const {
+    Frame const &fa = streams[a].queue.front();
+    Frame const &fb = streams[b].queue.front();
+    if (policy == PRIORITY) {
+      int64_t pa = streams[a].priority;
+      int64_t pb = streams[b].priority;
+      if (aging) {
+        pa += int64_t((now - fa.arrival) / aging);
+        pb += int64_t((now - fb.arrival) / aging);
+      }
+      if (pa != pb)
+        return pa > pb;
+    }
+    if ((policy != FIFO) && (fa.deadline != fb.deadline))
+      return fa.deadline < fb.deadline;
+    return fa.arrival < fb.arrival;
+  }
+
+  Backend &backend;
+  Policy const policy;
+  uint64_t const aging; // cycles per priority level gained while waiting
+  std::vector<Stream> streams;
+  std::deque<Dispatch> inflight;
+  uint64_t dispatched = 0;
+  uint64_t busy_total = 0; // cycles with a dispatch in flight
+};
+
+//- Streams ------------------------------------------------------------------
+struct StreamSpec {
+  std::string name;
+  int priority = 0;
+  double period = 0; // microseconds, or service times if period_f
+  double deadline = 0;
+  bool period_f = false;
+  bool deadline_f = false;
+  unsigned burst = 1;
+
+  uint64_t period_cycles = 0;
+  uint64_t deadline_cycles = 0;
+};
+
+static bool parse_time(std::string const &s, double &val, bool &frames) {
+  frames = !s.empty() && (s.back() == 'f');
+  char *end = nullptr;
+  std::string const num = frames ? s.substr(0, s.size() - 1) : s;
+  val = std::strtod(num.c_str(), &end);
+  return !num.empty() && (*end == '\0') && (val >= 0);
+}
+
+static bool parse_stream(std::string const &spec, StreamSpec &s) {
+  std::vector<std::string> f;
+  size_t pos = 0;
+  for (;;) {
+    size_t const colon = spec.find(':', pos);
+    f.push_back(spec.substr(pos, colon - pos));
+    if (colon == std::string::npos)
+      break;
+    pos = colon + 1;
+  }
+  if ((f.size() < 3) || (f.size() > 5) || f[0].empty())
+    return false;
+  s.name = f[0];
+  s.priority = std::atoi(f[1].c_str());
+  if (!parse_time(f[2], s.period, s.period_f) || (s.period <= 0))
+    return false;
+  if ((f.size() > 3) && !parse_time(f[3], s.deadline, s.deadline_f))
+    return false;
+  if (f.size() > 4)
+    s.burst = unsigned(std::max(1, std::atoi(f[4].c_str())));
+  return true;
+}
+
+static uint64_t percentile(std::vector<uint64_t> v, double p) {
+  if (v.empty())
+    return 0;
+  std::sort(v.begin(), v.end());
+  size_t const i = size_t(std::ceil(p / 100.0 * v.size()));
+  return v[i == 0 ? 0 : i - 1];
+}
+
+//- Main ---------------------------------------------------------------------
+int main(int argc, char **argv) {
+  std::vector<StreamSpec> streams;
+  std::string policy = "priority";
+  double duration_ms = 10.0;
+  double fmax = 200.0;
+  double aging_us = 0;
+  std::string json_path;
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if ((arg == "--stream") && (i + 1 < argc)) {
+      StreamSpec s;
+      if (!parse_stream(argv[++i], s)) {
+        std::cerr << "Invalid stream spec: " << argv[i] << '\n';
+        return 2;
+      }
+      streams.push_back(s);
+    } else if ((arg == "--policy") && (i + 1 < argc))
+      policy = argv[++i];
+    else if ((arg == "--duration-ms") && (i + 1 < argc))
+      duration_ms = std::atof(argv[++i]);
+    else if ((arg == "--fmax") && (i + 1 < argc))
+      fmax = std::atof(argv[++i]);
+    else if ((arg == "--aging-us") && (i + 1 < argc))
+      aging_us = std::atof(argv[++i]);
+    else if ((arg == "--json") && (i + 1 < argc))
+      json_path = argv[++i];
+    else {
+      streams.clear();
+      break;
+    }
+  }
+  if (streams.empty() ||
+      ((policy != "priority") && (policy != "edf") && (policy != "fifo"))) {
+    std::cerr << "Usage: " << argv[0]
+              << " --stream name:priority:period[:deadline[:burst]] ..."
+                 " [--policy priority|edf|fifo] [--duration-ms T]"
+                 " [--fmax MHz] [--aging-us A] [--json FILE]\n";
+    return 2;
+  }
+
+  std::unique_ptr<Backend> backend(new EmulatedBackend());
+
+  // Service time of one dispatch on an idle device, the unit of the 'f' time
+  // suffix, and the interval between back-to-back dispatches. Calibration
+  // also warms up the pipeline state of the free-running model.
+  uint64_t service = 0;
+  uint64_t interval = 0;
+  {
+    uint64_t cycle = 0;
+    std::vector<uint64_t> done; // completion cycles
+    auto const step = [&]() {
+      for (unsigned n = backend->step(); n > 0; n--)
+        done.push_back(cycle + 1);
+      cycle++;
+    };
+    backend->start(0, 0);
+    while (done.size() < 1)
+      step();
+    service = done[0];
+    backend->start(0, 1);
+    while (!backend->ready())
+      step();
+    backend->start(0, 2);
+    while (done.size() < 3)
+      step();
+    interval = done[2] - done[1];
+  }
+  double const cycles_per_us = fmax;
+  auto const to_cycles = [&](double v, bool f) {
+    return uint64_t(std::llround(f ? v * service : v * cycles_per_us));
+  };
+  for (auto &s : streams) {
+    s.period_cycles = std::max<uint64_t>(1, to_cycles(s.period, s.period_f));
+    s.deadline_cycles = to_cycles(s.deadline, s.deadline_f);
+  }
+  uint64_t const horizon = uint64_t(duration_ms * 1000.0 * cycles_per_us);
+  uint64_t const aging = uint64_t(aging_us * cycles_per_us);
+
+  Scheduler sched(*backend,
+                  policy == "edf"    ? Scheduler::EDF
+                  : policy == "fifo" ? Scheduler::FIFO
+                                     : Scheduler::PRIORITY,
+                  aging);
+  for (auto const &s : streams)
+    sched.add_stream(s.priority);
+
+  // Periodic replay: arrivals of all streams in time order
+  struct Arrival {
+    unsigned stream;
+    uint64_t time;
+    uint64_t deadline;
+  };
+  std::vector<Arrival> arrivals;
+  for (unsigned si = 0; si < streams.size(); si++) {
+    auto const &s = streams[si];
+    for (uint64_t t = 0; t < horizon; t += s.period_cycles)
+      for (unsigned b = 0; b < s.burst; b++)
+        arrivals.push_back(Arrival{
+            si, t, s.deadline_cycles ? t + s.deadline_cycles : UINT64_MAX});
+  }
+  std::stable_sort(arrivals.begin(), arrivals.end(),
+                   [](Arrival const &a, Arrival const &b) {
+                     return a.time < b.time;
+                   });
+
+  // The next dispatch starts as soon as the backend takes it, overlapping
+  // with the ones in flight; an idle backend skips to the next arrival.
+  uint64_t now = 0;
+  size_t next = 0;
+  for (;;) {
+    while ((next < arrivals.size()) && (arrivals[next].time <= now)) {
+      sched.submit(arrivals[next].stream, arrivals[next].time,
+                   arrivals[next].deadline);
+      next++;
+    }
+    sched.dispatch(now);
+    if (!sched.busy()) {
+      if (next == arrivals.size())
+        break;
+      now = arrivals[next].time;
+      continue;
+    }
+    sched.advance(now++);
+  }
+  uint64_t const busy = sched.busy_cycles();
+  uint64_t const dispatches = sched.dispatches();
+
+  // Report
+  auto const us = [&](uint64_t c) { return double(c) / cycles_per_us; };
+  std::string json;
+  char buf[512];
+  std::snprintf(buf, sizeof(buf),
+                "{\n  \"backend\": \"%s\", \"policy\": \"%s\", "
+                "\"fmax_mhz\": %.1f, \"aging_us\": %.1f, \"batch\": %u,\n"
+                "  \"service_cycles\": %llu, \"interval_cycles\": %llu, "
+                "\"dispatches\": %llu,\n"
+                "  \"makespan_us\": %.2f, \"utilization\": %.3f,\n"
+                "  \"streams\": [\n",
+                backend->name(), policy.c_str(), fmax, aging_us,
+                unsigned(DECONV_BATCH), (unsigned long long)service,
+                (unsigned long long)interval, (unsigned long long)dispatches,
+                us(now), now ? double(busy) / now : 0.0);
+  json += buf;
+  std::printf("%-12s %4s %8s %10s %10s %10s %10s %10s %10s %7s\n", "stream",
+              "prio", "frames", "qdelay_avg", "qdelay_p99", "lat_p50",
+              "lat_p95", "lat_p99", "lat_max", "missed");
+  for (unsigned si = 0; si < streams.size(); si++) {
+    auto const &s = streams[si];
+    auto const &st = sched.stats(si);
+    double qsum = 0;
+    for (uint64_t q : st.queue_delay)
+      qsum += double(q);
+    double const qavg =
+        st.queue_delay.empty() ? 0 : us(uint64_t(qsum / st.queue_delay.size()));
+    std::printf("%-12s %4d %8zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f "
+                "%7llu\n",
+                s.name.c_str(), s.priority, st.latency.size(), qavg,
+                us(percentile(st.queue_delay, 99)),
+                us(percentile(st.latency, 50)),
+                us(percentile(st.latency, 95)), us(percentile(st.latency, 99)),
+                us(percentile(st.latency, 100)), (unsigned long long)st.misses);
+    std::snprintf(
+        buf, sizeof(buf),
+        "    {\"name\": \"%s\", \"priority\": %d, \"period_us\": %.2f, "
+        "\"deadline_us\": %.2f, \"burst\": %u, \"frames\": %zu, "
+        "\"deadline_misses\": %llu,\n"
+        "     \"queue_delay_us\": {\"avg\": %.2f, \"p50\": %.2f, "
+        "\"p99\": %.2f, \"max\": %.2f},\n"
+        "     \"latency_us\": {\"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, "
+        "\"max\": %.2f}}%s\n",
+        s.name.c_str(), s.priority, us(s.period_cycles), us(s.deadline_cycles),
+        s.burst, st.latency.size(), (unsigned long long)st.misses, qavg,
+        us(percentile(st.queue_delay, 50)), us(percentile(st.queue_delay, 99)),
+        us(percentile(st.queue_delay, 100)), us(percentile(st.latency, 50)),
+        us(percentile(st.latency, 95)), us(percentile(st.latency, 99)),
+        us(percentile(st.latency, 100)), si + 1 < streams.size() ? "," : "");
+    json += buf;
+  }
+  json += "  ]\n}\n";
+  std::printf("(times in us at %.1f MHz, %llu cycles per dispatch, %llu "
+              "back to back, utilization %.1f%%)\n",
+              fmax, (unsigned long long)service, (unsigned long long)interval,
+              now ? 100.0 * busy / now : 0.0);
+
+  if (!json_path.empty()) {
+    std::ofstream ofs(json_path);
+    ofs << json;
+    std::cout << "Scheduler results written to " << json_path << std::endl;
+  }
+}
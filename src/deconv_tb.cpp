@@ -1,19 +1,291 @@
 #include "deconv_top.hpp"
+#include "deconv_top_frame.hpp"
+#include "utils.hpp"
+#ifdef DECONV_MAXI
+#include "deconv_maxi_top.hpp"
+#endif
+#ifdef DECONV_RESIZE_CONV
+#include "resize_conv.hpp"
+#endif
+#ifdef DECONV_HEADS
+#include "deconv.hpp"
+#endif
+#include "output_codec.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <vector>
+
+// Frames streamed back to back, used to measure the gap between consecutive
+// output frames. Every frame gets its own input and is checked on its own.
+#ifndef DECONV_TB_FRAMES
+#define DECONV_TB_FRAMES 1
+#endif
+
+// DECONV_HEADS = NH > 1 tests deconv_multi() in place of deconv_top(). Head 0
+// uses KERNEL and takes the place of the dst stream, so the CSV and every
+// check below apply to it. Head h uses KERNEL with its output channels
+// rotated by h: its channel c is channel (c+h)%CO of KERNEL, so its output
+// must be that of head 0 with the same rotation.
+#ifdef DECONV_HEADS
+#if defined(DECONV_RESIZE_CONV) || defined(DECONV_DEPTH_TO_SPACE) ||          \
+    defined(DECONV_MM2IM) || defined(DECONV_1D) || defined(DECONV_NM_SPARSE)
+#error "DECONV_HEADS needs the KERNEL of a plain 2D transposed convolution."
+#endif
+static_assert(D == 1, "deconv_multi() has no dilation.");
+static_assert(DECONV_ENCODE == DECONV_ENCODE_NONE,
+              "deconv_multi() has no output encoder.");
+
+constexpr unsigned KKSF = K * K * (CI / SIMD); // kernel beats per PE fold
+static TW head_kernel[DECONV_HEADS][(CO / PE) * KKSF][PE][SIMD];
+static std::vector<hls::vector<TO, PE>> head_out[DECONV_HEADS];
+#endif
+
+// Engine under test, one call per modelled cycle
+static void dut(hls::stream<hls::vector<TI, SIMD>> &src,
+                hls::stream<hls::vector<TO, PE>> &dst) {
+#ifdef DECONV_HEADS
+  static hls::stream<hls::vector<TO, PE>> res[DECONV_HEADS];
+  deconv_multi<DECONV_HEADS, K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE,
+               SIMD, DECONV_BATCH>(head_kernel, src, res);
+  if (!res[0].empty() && !stream_full(dst)) {
+    head_out[0].push_back(res[0].read());
+    dst.write(head_out[0].back());
+  }
+  for (unsigned h = 1; h < DECONV_HEADS; h++)
+    while (!res[h].empty())
+      head_out[h].push_back(res[h].read());
+#else
+  deconv_top(src, dst);
+#endif
+}
+
+//- Reference ----------------------------------------------------------------
+// Input of image b of frame f at row r, column c and channel ci. Image 0 of
+// the first frame is all ones like the golden data, and its output is written
+// to the CSV. Every other image varies with its position and channel, as well
+// as with the frame and image, so that spatial mistakes and state leaking
+// from one frame or image into another show as mismatches.
+static TI input(unsigned f, unsigned b, unsigned r, unsigned c, unsigned ci) {
+  if ((f == 0) && (b == 0))
+    return 1;
+  return TI(f * DECONV_BATCH + b + 3 * r + 5 * c + 7 * ci); // wraps
+}
+
+// Beat i of the src stream of frame f: beats are (pixel, SIMD fold, image)
+// with the image innermost.
+static hls::vector<TI, SIMD> input_beat(unsigned f, unsigned i) {
+  unsigned const b = i % DECONV_BATCH;
+  unsigned const d = i / DECONV_BATCH % (CI / SIMD);
+  unsigned const pix = i / DECONV_BATCH / (CI / SIMD);
+  hls::vector<TI, SIMD> x;
+  for (unsigned simd = 0; simd < SIMD; simd++)
+    x[simd] = input(f, b, pix / W, pix % W, d * SIMD + simd);
+  return x;
+}
+
+// Weight between input channel ci and output channel co at kernel tap
+// (kh, kw), read back from KERNEL in the layout of the engine under test
+static unsigned weight(unsigned co, unsigned ci, unsigned kh, unsigned kw) {
+  constexpr unsigned SF = CI / SIMD;
+  unsigned const cf = co / PE, pe = co % PE;
+  unsigned const d = ci / SIMD, simd = ci % SIMD;
+#if defined(DECONV_DEPTH_TO_SPACE)
+  // Phase (sh, sw) of the stride-1 kernel holds the taps S*(KK-1-i) + sh
+  constexpr unsigned KK = K / S;
+  unsigned const i = KK - 1 - kh / S, j = KK - 1 - kw / S;
+  unsigned const n =
+      (((((kh % S) * S + kw % S) * (CO / PE) + cf) * KK + i) * KK + j) * SF + d;
+  return KERNEL[n][pe][simd];
+#elif defined(DECONV_NM_SPARSE)
+  // NM_N stored weights per NM_M lanes, each with its lane in KERNEL_POS
+  unsigned const n = ((cf * K + kh) * K + kw) * SF + d;
+  unsigned const g = simd / NM_M * NM_N;
+  for (unsigned j = g; j < g + NM_N; j++)
+    if (KERNEL_POS[n][pe][j] == simd % NM_M)
+      return KERNEL[n][pe][j];
+  return 0;
+#elif defined(DECONV_1D)
+  return KERNEL[(cf * K + kw) * SF + d][pe][simd];
+#else
+  return KERNEL[((cf * K + kh) * K + kw) * SF + d][pe][simd];
+#endif
+}
+
+#ifdef DECONV_RESIZE_CONV
+// Sample of the input of image b of frame f upsampled by S at row r and
+// column c. Bilinear samples follow align_corners=False and are scaled by
+// (2S)^2 to stay integral, as in resize_conv().
+static unsigned long upsampled(unsigned f, unsigned b, unsigned ci, unsigned r,
+                               unsigned c) {
+  if (RESIZE == RESIZE_NEAREST)
+    return input(f, b, r / S, c / S, ci);
+  // Source samples of o along an axis of n and the weight of the second,
+  // out of 2S
+  auto const taps = [](unsigned o, unsigned n, unsigned i[2], unsigned w[2]) {
+    unsigned const num = 2 * o + 1 > S ? 2 * o + 1 - S : 0;
+    i[0] = num / (2 * S);
+    i[1] = std::min(i[0] + 1, n - 1);
+    w[1] = num % (2 * S);
+    w[0] = 2 * S - w[1];
+  };
+  unsigned ir[2], wr[2], ic[2], wc[2];
+  taps(r, H, ir, wr);
+  taps(c, W, ic, wc);
+  unsigned long u = 0;
+  for (unsigned a = 0; a < 2; a++)
+    for (unsigned e = 0; e < 2; e++)
+      u += wr[a] * wc[e] * input(f, b, ir[a], ic[e], ci);
+  return u;
+}
+#endif
+
+// Expected dst beats of frame f, computed directly: the ConvTranspose2d (or
+// ConvTranspose1d) of its input, or for resize engines the stride-1 Conv2d of
+// its upsampled input. Output beats are (pixel, PE fold, image) with the image
+// innermost; lane pe of fold cf is channel cf*PE + pe.
+static std::vector<hls::vector<TO, PE>> reference(unsigned f) {
+  using F = deconv_top_frame;
+  std::vector<unsigned long> y(F::OUT_BEATS * PE, 0);
+  auto const acc = [&](unsigned b, unsigned co, int r, int c,
+                       unsigned long v) {
+    if ((r < 0) || (r >= int(F::HO)) || (c < 0) || (c >= int(F::WO)))
+      return;
+    unsigned const beat =
+        ((r * F::WO + c) * (CO / PE) + co / PE) * DECONV_BATCH + b;
+    y[beat * PE + co % PE] += v;
+  };
+#ifdef DECONV_1D
+  constexpr unsigned KH = 1; // a single row, PT and PB do not apply
+  constexpr int PAD_T = 0;
+#else
+  constexpr unsigned KH = K;
+  constexpr int PAD_T = PT;
+#endif
+  for (unsigned b = 0; b < DECONV_BATCH; b++)
+    for (unsigned co = 0; co < CO; co++)
+      for (unsigned ci = 0; ci < CI; ci++)
+        for (unsigned kh = 0; kh < KH; kh++)
+          for (unsigned kw = 0; kw < K; kw++) {
+            unsigned long const w = weight(co, ci, kh, kw);
+#ifdef DECONV_RESIZE_CONV
+            for (unsigned r = 0; r < F::HO; r++)
+              for (unsigned c = 0; c < F::WO; c++) {
+                int const ur = int(r + kh) - PAD_T;
+                int const uc = int(c + kw) - int(PL);
+                if ((ur >= 0) && (ur < int(S * H)) && (uc >= 0) &&
+                    (uc < int(S * W)))
+                  acc(b, co, r, c, upsampled(f, b, ci, ur, uc) * w);
+              }
+#else
+            for (unsigned r = 0; r < (KH == 1 ? 1 : H); r++)
+              for (unsigned c = 0; c < W; c++)
+                acc(b, co, int(r * S + D * kh) - PAD_T,
+                    int(c * S + D * kw) - int(PL),
+                    input(f, b, r, c, ci) * w);
+#endif
+          }
+  std::vector<hls::vector<TO, PE>> out(F::OUT_BEATS);
+  for (unsigned i = 0; i < F::OUT_BEATS; i++)
+    for (unsigned pe = 0; pe < PE; pe++)
+      out[i][pe] = TO(y[i * PE + pe]);
+  return out;
+}
 
 int main() {
+#ifdef DECONV_HEADS
+  for (unsigned h = 0; h < DECONV_HEADS; h++)
+    for (unsigned n = 0; n < (CO / PE) * KKSF; n++)
+      for (unsigned pe = 0; pe < PE; pe++) {
+        unsigned const c = ((n / KKSF) * PE + pe + h) % CO;
+        for (unsigned simd = 0; simd < SIMD; simd++)
+          head_kernel[h][n][pe][simd] =
+              KERNEL[(c / PE) * KKSF + n % KKSF][c % PE][simd];
+      }
+#endif
+
   hls::stream<hls::vector<TI, SIMD>> src;
   hls::stream<hls::vector<TO, PE>> dst;
 
-  for (unsigned h = 0; h < H; h++) {
-    for (unsigned w = 0; w < W; w++) {
-      // src.write(TI(h*W + w));
-      src.write(TI(1));
+  // Top-level port depths (only effective with DECONV_CSIM_BOUNDED)
+  stream_depth(src, DECONV_CSIM_PORT_DEPTH);
+  stream_depth(dst, DECONV_CSIM_PORT_DEPTH);
+
+  // Input is fed as the src port admits it: all at once when unbounded,
+  // FIFO by FIFO with DECONV_CSIM_BOUNDED.
+  // With DECONV_BATCH > 1 every beat carries the images of the batch
+  // innermost. See input() for the values fed.
+  unsigned const frames = DECONV_TB_FRAMES;
+  unsigned const batch = DECONV_BATCH;
+  unsigned const in_beats = frames * deconv_top_frame::IN_BEATS;
+  unsigned fed = 0;
+  auto const feed = [&]() {
+    while ((fed < in_beats) && !stream_full(src)) {
+      src.write(input_beat(fed / deconv_top_frame::IN_BEATS,
+                           fed % deconv_top_frame::IN_BEATS));
+      fed++;
     }
+  };
+#ifdef DECONV_MAXI
+  fed = in_beats; // read from DDR by deconv_maxi_read() below
+#else
+  feed();
+#endif
+
+  unsigned const out_beats = deconv_top_frame::OUT_BEATS;
+  // Every output beat of every frame and image is checked against reference()
+  // of the frame being received
+  std::vector<hls::vector<TO, PE>> expected;
+  std::vector<unsigned long> frame_first(frames, 0); // call of first beat
+  std::vector<unsigned long> frame_last(frames, 0);  // call of last beat
+  unsigned long call = 0;
+  unsigned long received = 0;
+  unsigned long encoded = 0; // dst beats before decoding
+  output_decoder<out_beats, deconv_top_frame::CB, DECONV_ENCODE_GROUP,
+                 DECONV_ENCODE, PE, TO>
+      decoder;
+  std::vector<hls::vector<TO, PE>> decoded;
+  unsigned errors = 0;
+
+  // Cropped rows between back-to-back frames produce no output for a while;
+  // only give up early once every expected beat has arrived.
+  unsigned long const stall_limit =
+      200 + 2UL * K * S * (W * S + 2 * K) * (CO / PE) * K * K * (CI / SIMD) *
+                batch;
+
+#ifdef DECONV_MAXI
+  // One launch of deconv_maxi_read() and deconv_maxi_write() for all frames,
+  // with the free-running engine stepped in between until it has produced
+  // every output beat. The frames are spaced apart in the host buffers to
+  // exercise the stride registers; the written output is replayed through
+  // dst and checked as for the stream top.
+  unsigned const src_stride = in_beats / frames + 16;
+  unsigned const dst_stride = out_beats + 16;
+  std::vector<hls::vector<TI, SIMD>> src_buf(frames * src_stride);
+  std::vector<hls::vector<TO, PE>> dst_buf(frames * dst_stride);
+  for (unsigned f = 0; f < frames; f++)
+    for (unsigned i = 0; i < in_beats / frames; i++)
+      src_buf[f * src_stride + i] = input_beat(f, i);
+  deconv_maxi_read(src_buf.data(), src_stride, frames, src);
+  hls::stream<hls::vector<TO, PE>> res;
+  for (unsigned long idle = 0;
+       (res.size() < size_t(frames) * out_beats) && (idle < stall_limit);) {
+    size_t const n = res.size();
+    dut(src, res);
+    idle = res.size() == n ? idle + 1 : 0;
+  }
+  if (res.size() < size_t(frames) * out_beats) {
+    std::cerr << "Engine stalled after " << res.size() << " of "
+              << frames * out_beats << " output beats\n";
+    return 1;
   }
+  deconv_maxi_write(res, dst_buf.data(), dst_stride, frames);
+  for (unsigned f = 0; f < frames; f++)
+    for (unsigned i = 0; i < out_beats; i++)
+      dst.write(dst_buf[f * dst_stride + i]);
+#endif
 
   unsigned cnt = 0;
   unsigned timeout = 0;
@@ -39,18 +311,43 @@ int main() {
   std::string fname = std::string("deconv_") + std::to_string(W) + "x" +
                       std::to_string(H) + "_in" + std::to_string(CI) + "_out" +
                       std::to_string(CO) + "_k" + std::to_string(K) + "_s" +
-                      std::to_string(S) + "_p" + std::to_string(P) +
-                      "_output_hls.csv";
+                      std::to_string(S) + "_p" + std::to_string(P);
+  if ((PB != PT) || (PL != PT) || (PR != PT))
+    fname += "_pb" + std::to_string(PB) + "_pl" + std::to_string(PL) + "_pr" +
+             std::to_string(PR);
+  if (OPH != 0)
+    fname += "_op" + std::to_string(OPH);
+  if (D != 1)
+    fname += "_d" + std::to_string(D);
+#ifdef DECONV_RESIZE_CONV
+  fname += (RESIZE == RESIZE_BILINEAR ? "_bl" : "_nn") + std::to_string(S);
+#endif
+#ifdef DECONV_NM_SPARSE
+  fname += "_nm" + std::to_string(NM_N) + "of" + std::to_string(NM_M);
+#endif
+#ifdef DECONV_DEPTH_TO_SPACE
+  fname += "_ps" + std::to_string(S);
+#endif
+#ifdef DECONV_MM2IM
+  fname += "_mm" + std::to_string(S);
+#endif
+  fname += "_output_hls.csv";
   static std::ofstream ofs(fname);
   if (!ofs.is_open()) {
     std::cerr << "Failed to open CSV output file\n";
     return 1;
   }
-  while (timeout < 200) {
-    deconv_top(src, dst);
-    if (dst.empty())
-      timeout++;
-    else {
+  while (timeout < (received < frames * out_beats ? stall_limit : 200)) {
+    feed();
+#ifndef DECONV_MAXI
+    dut(src, dst);
+#endif
+    call++;
+    if (dst.empty()) {
+      // Only count idle cycles once the whole input has been consumed
+      if ((fed == in_beats) && src.empty())
+        timeout++;
+    } else {
       // build filename from constexpr params in top.hpp
 
       // auto const y = dst.read();
@@ -73,14 +370,99 @@ int main() {
       // }
       // timeout = 0;
 
-      auto const y = dst.read();
-      for (unsigned pe = 0; pe < PE; pe++) {
-        std::cout << std::setw(4) << y[pe] << '\n';
-        ofs << y[pe] << '\n';
+      encoded++;
+      decoded.clear();
+      decoder.push(dst.read(), decoded);
+      for (auto const &y : decoded) {
+        unsigned const f = received / out_beats;
+        unsigned const i = received % out_beats;
+        if (f < frames) {
+          if (i == 0) {
+            frame_first[f] = call;
+            expected = reference(f);
+          }
+          frame_last[f] = call;
+        }
+        if ((f == 0) && (i % batch == 0)) {
+          for (unsigned pe = 0; pe < PE; pe++) {
+            std::cout << std::setw(4) << y[pe] << '\n';
+            ofs << y[pe] << '\n';
+          }
+        }
+        for (unsigned pe = 0; pe < PE; pe++)
+          if ((f >= frames) || (y[pe] != expected[i][pe]))
+            errors++;
+        received++;
       }
       timeout = 0;
     }
   }
   ofs.close();
   std::cout << "Output written to " << fname << std::endl;
+  if (DECONV_ENCODE != DECONV_ENCODE_NONE)
+    std::cout << "Encoded output: " << encoded << " dst beats for "
+              << received << " output beats (ratio "
+              << double(encoded) / (received ? received : 1) << ")\n";
+
+  if (received != static_cast<unsigned long>(frames) * out_beats) {
+    std::cerr << "Received " << received << " output beats, expected "
+              << frames * out_beats << '\n';
+    return 1;
+  }
+  std::cout << "Reference: " << frames << " frame(s) of " << batch
+            << " image(s)"
+            << (errors == 0 ? ", all match"
+                            : ", mismatches=" + std::to_string(errors))
+            << std::endl;
+  if (errors != 0)
+    return 1;
+
+  // Back-to-back Frame Report (one deconv_top call per modelled cycle)
+  if (frames > 1) {
+#ifndef DECONV_MAXI
+    // Frame timing is only modelled for the stream top
+    for (unsigned f = 1; f < frames; f++)
+      std::cout << "frame" << f
+                << ": interval=" << frame_first[f] - frame_first[f - 1]
+                << " gap=" << frame_first[f] - frame_last[f - 1] << '\n';
+    // Spacing of output beats within a frame: the gap a seamless transition
+    // between frames would show
+    double const spacing =
+        out_beats > 1
+            ? double(frame_last[0] - frame_first[0]) / (out_beats - 1)
+            : 0.0;
+    if (out_beats > 1)
+      std::cout << "in-frame beat spacing=" << spacing << '\n';
+#endif
+    std::cout << "Back-to-back frames: " << frames
+              << ", first frame calls=" << frame_last[0] << std::endl;
+  }
+#ifdef DECONV_HEADS
+  // Output beats are (pixel, PE fold, image); lane pe of fold cf is channel
+  // cf*PE + pe.
+  unsigned head_errors = 0;
+  for (unsigned h = 1; h < DECONV_HEADS; h++) {
+    if (head_out[h].size() != head_out[0].size()) {
+      std::cerr << "Head " << h << " produced " << head_out[h].size()
+                << " output beats, head 0 " << head_out[0].size() << '\n';
+      return 1;
+    }
+    for (size_t i = 0; i < head_out[h].size(); i++) {
+      unsigned const j = i % deconv_top_frame::CB; // beat within the pixel
+      for (unsigned pe = 0; pe < PE; pe++) {
+        unsigned const c = ((j / batch) * PE + pe + h) % CO;
+        auto const &ref = head_out[0][i - j + (c / PE) * batch + j % batch];
+        if (head_out[h][i][pe] != ref[c % PE])
+          head_errors++;
+      }
+    }
+  }
+  std::cout << "Heads: " << DECONV_HEADS << " heads of deconv_multi()"
+            << (head_errors == 0
+                    ? ", all match head 0 rotated"
+                    : ", mismatches=" + std::to_string(head_errors))
+            << std::endl;
+  if (head_errors != 0)
+    return 1;
+#endif
 }
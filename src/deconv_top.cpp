@@ -1,5 +1,15 @@
 #include "deconv_top.hpp"
+#include "deconv_top_frame.hpp"
+#ifdef DECONV_RESIZE_CONV
+#include "resize_conv.hpp"
+#elif defined(DECONV_MM2IM)
+#include "mm2im.hpp"
+#elif defined(DECONV_1D)
+#include "deconv1d.hpp"
+#else
 #include "deconv.hpp"
+#endif
+#include "output_codec.hpp"
 
 
 void deconv_top(
@@ -12,6 +22,42 @@ void deconv_top(
 
 #pragma HLS dataflow disable_start_propagation
 
-	deconv<K, S, P, H, W, CO, CI, PE, SIMD>(KERNEL, src, dst);
+#if DECONV_ENCODE != DECONV_ENCODE_NONE
+	// Engine output, encoded for DDR by output_encoder()
+	static hls::stream<hls::vector<TO, PE>>  res("res");
+	DECONV_STREAM_DEPTH(res, 2);
+#else
+	hls::stream<hls::vector<TO, PE>> &res = dst;
+#endif
+
+#if defined(DECONV_RESIZE_CONV) || defined(DECONV_DEPTH_TO_SPACE) || defined(DECONV_MM2IM) || defined(DECONV_1D)
+	static_assert(D == 1, "Dilation is only supported by the deconv_swg() based engines.");
+#endif
+#ifdef DECONV_RESIZE_CONV
+	// Alternative upsampling engine: resize by S, then stride-1 convolution
+	resize_conv<RESIZE, S, K, PT, PB, PL, PR, H, W, CO, CI, PE, SIMD, DECONV_BATCH>(KERNEL, src, res);
+#elif defined(DECONV_DEPTH_TO_SPACE)
+	// Stride-1 convolution to S*S*CO channels followed by depth-to-space
+	deconv_d2s<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE, SIMD, DECONV_BATCH>(KERNEL, src, res);
+#elif defined(DECONV_MM2IM)
+	// Per-pixel matrix multiplication followed by col2im overlap-add
+	mm2im<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE, SIMD, DECONV_BATCH>(KERNEL, src, res);
+#elif defined(DECONV_1D)
+	// ConvTranspose1d over the W samples of an H = 1 input
+	deconv1d<K, S, PL, PR, OPW, W, CO, CI, PE, SIMD, DECONV_BATCH>(KERNEL, src, res);
+#elif defined(DECONV_NM_SPARSE)
+	// N:M sparse kernel: NM_N stored weights and positions per NM_M channels
+	deconv_nm<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE, SIMD, NM_N, NM_M, DECONV_BATCH, D>(KERNEL, KERNEL_POS, src, res);
+#elif (DECONV_TILE_X > 1) || (DECONV_TILE_Y > 1)
+	// Every weight beat applied to a DECONV_TILE_X x DECONV_TILE_Y tile of windows
+	deconv_tiled<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE, SIMD, DECONV_TILE_X, DECONV_TILE_Y, DECONV_BATCH, D>(KERNEL, src, res);
+#else
+	deconv_asym<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CO, CI, PE, SIMD, DECONV_BATCH, D>(KERNEL, src, res);
+#endif
+
+#if DECONV_ENCODE != DECONV_ENCODE_NONE
+	using  F = deconv_top_frame;
+	DECONV_STAGE(encode, output_encoder<F::OUT_BEATS, F::CB, DECONV_ENCODE_GROUP, DECONV_ENCODE>(res, dst));
+#endif
 
 } // deconv_top()
@@ -7,7 +7,14 @@
 
 constexpr unsigned  K = 4;		// kernel Size
 constexpr unsigned  S = 2; 		// stride
+constexpr unsigned  D = 1;		// dilation
 constexpr unsigned  P = K-S;	// (de)padding
+constexpr unsigned  PT = P;		// padding top
+constexpr unsigned  PB = P;		// padding bottom
+constexpr unsigned  PL = P;		// padding left
+constexpr unsigned  PR = P;		// padding right
+constexpr unsigned  OPH = 0;		// output padding (bottom)
+constexpr unsigned  OPW = 0;		// output padding (right)
 constexpr unsigned  H = 6;		// IFM height
 constexpr unsigned  W = 6;		// IFM Width
 constexpr unsigned  CI = 1;		// input channels
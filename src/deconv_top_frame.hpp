@@ -0,0 +1,29 @@
+#ifndef DECONV_TOP_FRAME_HPP
+#define DECONV_TOP_FRAME_HPP
+
+#include "deconv_top.hpp"
+#include "utils.hpp"
+
+//- Frame Geometry of deconv_top() -------------------------------------------
+// Output size of a frame of the configuration in deconv_top.hpp and its beat
+// counts on the src and dst streams.
+struct deconv_top_frame {
+#ifdef DECONV_RESIZE_CONV
+	// Stride-1 Conv2d on the input upsampled by S
+	static constexpr unsigned  HO = S*H + PT + PB - K + 1;
+	static constexpr unsigned  WO = S*W + PL + PR - K + 1;
+#elif defined(DECONV_1D)
+	// ConvTranspose1d over the W samples of an H = 1 input
+	static constexpr unsigned  HO = 1;
+	static constexpr unsigned  WO = (W-1)*S + K - PL - PR + OPW;
+#else
+	// ConvTranspose2d
+	static constexpr unsigned  HO = (H-1)*S + D*(K-1)+1 - PT - PB + OPH;
+	static constexpr unsigned  WO = (W-1)*S + D*(K-1)+1 - PL - PR + OPW;
+#endif
+	static constexpr unsigned  CB = (CO/PE)*DECONV_BATCH;	// beats per output pixel
+	static constexpr unsigned  IN_BEATS  = H*W*(CI/SIMD)*DECONV_BATCH;
+	static constexpr unsigned  OUT_BEATS = HO*WO*CB;
+};
+
+#endif
@@ -0,0 +1,311 @@
+/****************************************************************************
+ * MM2IM: transposed convolution as a matrix multiplication followed by an
+ * on-chip col2im overlap-add, an alternative to the window replay of
+ * deconv_swg() in deconv.hpp.
+ *
+ * Every input pixel x[h][w][:] is multiplied by the CI x (CO*K*K) kernel
+ * matrix, and the resulting column of K*K output patches is added into the
+ * output at (h*S + kh, w*S + kw):
+ *
+ *   mm2im_replay -> deconv_mvu (PE x SIMD tile) -> col2im
+ *
+ * mm2im_replay() holds the SF beats of a pixel and replays them for the
+ * CO/PE * K*K column tiles, while conv_weights() replays the native kernel
+ * [CO/PE][K][K][CI/SIMD][PE][SIMD] cyclically. The matrix multiplication
+ * therefore touches only real pixels, never zero padding. col2im() keeps a
+ * ring of output rows. Rows that no later input row can reach are drained,
+ * cropped by the padding, while the next input rows are accumulated. Any
+ * K and S work, including S not dividing K, which deconv_asym() rejects.
+ ***************************************************************************/
+#ifndef MM2IM_HPP
+#define MM2IM_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#include "deconv.hpp"
+#include "utils.hpp"
+
+//- Pixel Replay -------------------------------------------------------------
+template<
+	unsigned  N,	// beats per pixel
+	unsigned  R,	// replays per pixel
+	typename  T
+>
+void mm2im_replay(
+	hls::stream<T> &src,
+	hls::stream<T> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	// Double-buffered: the next pixel is loaded while the current one replays
+	static T  buf[2][N];
+	static bool  full[2] = { false, false };
+	static ap_uint<1>  wsel = 0;
+	static ap_uint<1>  rsel = 0;
+	static unsigned  wi = 0;
+	static unsigned  ri = 0;
+	static unsigned  rep = 0;
+#pragma HLS array_partition variable=buf dim=1 complete
+#pragma HLS reset variable=full
+#pragma HLS reset variable=wsel
+#pragma HLS reset variable=rsel
+#pragma HLS reset variable=wi
+#pragma HLS reset variable=ri
+#pragma HLS reset variable=rep
+
+	if(full[rsel] && !stream_full(dst)) {
+		dst.write(buf[rsel][ri]);
+		if(ri < N-1)  ri++;
+		else {
+			ri = 0;
+			if(rep < R-1)  rep++;
+			else {
+				rep = 0;
+				full[rsel] = false;
+				rsel = !rsel;
+			}
+		}
+	}
+
+	if(!full[wsel] && !src.empty()) {
+		buf[wsel][wi] = src.read();
+		if(wi < N-1)  wi++;
+		else {
+			wi = 0;
+			full[wsel] = true;
+			wsel = !wsel;
+		}
+	}
+
+} // mm2im_replay()
+
+//- Column-to-Image Overlap-Add ----------------------------------------------
+// Consumes the K*K*C beats of every input pixel in (c, kh, kw, b) order and
+// adds them into a ring of R uncropped output rows. Input row h claims the
+// rows up to h*S+K-1. When it completes, the rows above (h+1)*S are final
+// and are emitted in (row, column, c, b) order, skipping the cropped border
+// and clearing the ring behind them. The ring spans K + 2S rows, so one
+// batch of S rows drains while the next input row accumulates.
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S,	// stride
+	unsigned  PT,	// rows cropped at the top
+	unsigned  PB,	// rows cropped at the bottom
+	unsigned  PL,	// columns cropped at the left
+	unsigned  PR,	// columns cropped at the right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  C,	// channel fold (CO/PE)
+	unsigned  B,	// batch of images interleaved beat by beat
+	size_t    PE,
+	typename  TO
+>
+void col2im(
+	hls::stream<hls::vector<TO, PE>> &src,
+	hls::stream<hls::vector<TO, PE>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	constexpr unsigned  HF = (H-1)*S + K + OPH;	// uncropped output height
+	constexpr unsigned  WF = (W-1)*S + K + OPW;	// uncropped output width
+	constexpr unsigned  CB = C*B;			// beats per output pixel
+	constexpr unsigned  R  = K + 2*S + OPH;		// ring rows
+	static_assert(PT+PB < HF, "Cropping must leave output rows.");
+	static_assert(PL+PR < WF, "Cropping must leave output columns.");
+
+	static TO  buf[R][WF*CB][PE];
+#pragma HLS array_partition variable=buf dim=1 complete
+#pragma HLS array_partition variable=buf dim=3 complete
+	// Same-address updates are (C*K*K-S)*B beats apart: column w*S+kw is
+	// revisited with kw-S by the next input pixel, same (c, kh, b). Without
+	// column overlap (K <= S), only the next input row revisits it.
+	constexpr unsigned  RMW = K > S? (C*K*K - S)*B : W*C*K*K*B;
+	static_assert(RMW > 1, "Consecutive beats must not update the same address.");
+#pragma HLS dependence variable=buf inter true distance=RMW
+
+	// Ring occupancy: free rows and rows complete but not yet drained. The
+	// output padding rows of a frame are claimed by the first row of the
+	// next, hence the initial credit.
+	static unsigned  avail = R + OPH;
+	static unsigned  ready = 0;
+#pragma HLS reset variable=avail
+#pragma HLS reset variable=ready
+
+	// Accumulation side
+	static unsigned  ih = 0;
+	static unsigned  iw = 0;
+	static unsigned  ic = 0;
+	static unsigned  ikh = 0;
+	static unsigned  ikw = 0;
+	static unsigned  ib = 0;
+	static unsigned  itop = 0;	// ring slot of row ih*S
+	static bool  iclaim = false;	// rows of input row ih claimed
+#pragma HLS reset variable=ih
+#pragma HLS reset variable=iw
+#pragma HLS reset variable=ic
+#pragma HLS reset variable=ikh
+#pragma HLS reset variable=ikw
+#pragma HLS reset variable=ib
+#pragma HLS reset variable=itop
+#pragma HLS reset variable=iclaim
+
+	// Drain side
+	static unsigned  er = 0;
+	static unsigned  ec = 0;
+	static unsigned  ej = 0;
+	static unsigned  eslot = 0;
+	static bool  erow = false;	// row er started
+#pragma HLS reset variable=er
+#pragma HLS reset variable=ec
+#pragma HLS reset variable=ej
+#pragma HLS reset variable=eslot
+#pragma HLS reset variable=erow
+
+	unsigned  freed = 0;
+	unsigned  claimed = 0;
+	unsigned  completed = 0;
+	unsigned  started = 0;
+
+	// Drain a final row, cropped
+	if(!erow && (ready > 0)) {
+		erow = true;
+		started = 1;
+	}
+	if(erow) {
+		bool const  keep = (PT <= er) && (er < HF-PB) && (PL <= ec) && (ec < WF-PR);
+		if(!keep || !stream_full(dst)) {
+			unsigned const  addr = ec*CB + ej;
+			hls::vector<TO, PE>  y;
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				y[pe] = buf[eslot][addr][pe];
+				buf[eslot][addr][pe] = 0;
+			}
+			if(keep)  dst.write(y);
+
+			if(ej < CB-1)  ej++;
+			else {
+				ej = 0;
+				if(ec < WF-1)  ec++;
+				else {
+					ec = 0;
+					erow = false;
+					freed = 1;
+					eslot = eslot < R-1? eslot+1 : 0;
+					er = er < HF-1? er+1 : 0;
+				}
+			}
+		}
+	}
+
+	// Accumulate a column beat
+	if(!iclaim) {
+		unsigned const  need = ih == 0? K+OPH : S;
+		if(avail >= need) {
+			iclaim = true;
+			claimed = need;
+		}
+	}
+	if(iclaim && !src.empty()) {
+		auto const  x = src.read();
+		unsigned const  slot = itop+ikh < R? itop+ikh : itop+ikh-R;
+		unsigned const  addr = (iw*S + ikw)*CB + ic*B + ib;
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			buf[slot][addr][pe] += x[pe];
+		}
+
+		if(ib < B-1)  ib++;
+		else {
+			ib = 0;
+			if(ikw < K-1)  ikw++;
+			else {
+				ikw = 0;
+				if(ikh < K-1)  ikh++;
+				else {
+					ikh = 0;
+					if(ic < C-1)  ic++;
+					else {
+						ic = 0;
+						if(iw < W-1)  iw++;
+						else {
+							// Input row complete
+							iw = 0;
+							iclaim = false;
+							unsigned const  step = ih < H-1? S : K+OPH;
+							completed = step;
+							itop = itop+step < R? itop+step : itop+step-R;
+							ih = ih < H-1? ih+1 : 0;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	avail = avail + freed - claimed;
+	ready = ready + completed - started;
+
+} // col2im()
+
+//===========================================================================
+// MM2IM Transposed Convolution
+
+template<
+	unsigned  K,	// kernel Size
+	unsigned  S, 	// stride
+	unsigned  PT,	// (de)padding top
+	unsigned  PB,	// (de)padding bottom
+	unsigned  PL,	// (de)padding left
+	unsigned  PR,	// (de)padding right
+	unsigned  OPH,	// output padding, added below the bottom row
+	unsigned  OPW,	// output padding, added right of the rightmost column
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,	// matrix tile: output channels per beat
+	size_t    SIMD,	// matrix tile: input channels per beat
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void mm2im(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+
+	// Continuous Weight Feed: the native kernel, once per input pixel
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, conv_weights(kernel, wgt));
+
+	// Activation Processing Pipeline: replay -> mvu -> col2im (incl. cropping)
+	static hls::stream<hls::vector<TI, SIMD>>  rep("rep");
+	static hls::stream<hls::vector<TO, PE>>  col("col");
+	DECONV_STREAM_DEPTH(rep, 2);
+	DECONV_STREAM_DEPTH(col, 2);
+
+	DECONV_STAGE(replay, mm2im_replay<SF*B, CF*K*K>(src, rep));
+	DECONV_STAGE(mvu, deconv_mvu_sel<SF, B>(wgt, rep, col));
+	DECONV_STAGE(col2im, col2im<K, S, PT, PB, PL, PR, OPH, OPW, H, W, CF, B>(col, dst));
+
+} // mm2im()
+
+#endif
@@ -0,0 +1,253 @@
+/****************************************************************************
+ * Output stream encoding towards DDR.
+ *
+ * High-CO upsampling layers are bound by their output bandwidth: every
+ * output beat carries PE x TO bits. output_encoder() follows the engine
+ * (after crop()) and shrinks the stream according to the data:
+ *
+ *   DECONV_ENCODE_BITMAP  zero suppression for post-activation sparsity
+ *   DECONV_ENCODE_DELTA   difference to the previous pixel of the same
+ *                         channels, then zero suppression; flat regions of
+ *                         smooth maps become zeros
+ *
+ * The frame of N beats is coded in groups of G beats. A group is sent as a
+ * mask beat, whose lane pe holds bit g set when lane pe of beat g is nonzero,
+ * followed by the nonzero values in (beat, lane) order, packed PE per beat
+ * with the last beat zero-filled. A group thus takes 1 + ceil(nnz/PE) beats:
+ * G/(G+1) of the raw stream when dense, a single beat when all zero. Groups
+ * do not straddle frames.
+ *
+ * output_decoder is the host-side inverse for the testbench and the host
+ * benchmark.
+ ***************************************************************************/
+#ifndef OUTPUT_CODEC_HPP
+#define OUTPUT_CODEC_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#include "utils.hpp"
+
+#ifndef __SYNTHESIS__
+#include <vector>
+#endif
+
+//- Output Encoder -----------------------------------------------------------
+template<
+	unsigned  N,	// beats per frame
+	unsigned  P,	// beats per output pixel, distance of the delta reference
+	unsigned  G,	// beats per group, at most the bit width of T
+	unsigned  MODE,	// DECONV_ENCODE_BITMAP or DECONV_ENCODE_DELTA
+	size_t    PE,
+	typename  T
+>
+void output_encoder(
+	hls::stream<hls::vector<T, PE>> &src,
+	hls::stream<hls::vector<T, PE>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static_assert((MODE == DECONV_ENCODE_BITMAP) || (MODE == DECONV_ENCODE_DELTA), "Unknown output encoding.");
+	static_assert(N%P == 0, "Frames must consist of whole pixels.");
+	constexpr bool  DELTA = MODE == DECONV_ENCODE_DELTA;
+
+	// Double-buffered groups: the next group is packed while one is sent
+	static ap_uint<G>  mask[2][PE];
+	static T  data[2][G][PE];
+	static unsigned  cnt[2] = { 0, 0 };	// packed data beats
+	static bool  full[2] = { false, false };
+	static ap_uint<1>  wsel = 0;
+	static ap_uint<1>  rsel = 0;
+	static unsigned  ro = 0;	// beat sent next: 0 mask, else data[ro-1]
+#pragma HLS array_partition variable=mask complete
+#pragma HLS array_partition variable=data dim=1 complete
+#pragma HLS array_partition variable=data dim=3 complete
+#pragma HLS dependence variable=data inter false
+#pragma HLS reset variable=cnt
+#pragma HLS reset variable=full
+#pragma HLS reset variable=wsel
+#pragma HLS reset variable=rsel
+#pragma HLS reset variable=ro
+
+	// Packing side
+	static ap_uint<G>  m[PE];	// mask of the group being packed
+	static T  pack[PE];	// nonzero values short of a beat, zero beyond np
+	static unsigned  np = 0;
+	static unsigned  dn = 0;	// data beats of the group being packed
+	static unsigned  i = 0;	// beat within the frame
+	static unsigned  g = 0;	// beat within the group
+	static T  ref[P][PE];	// previous pixel (delta coding)
+	static unsigned  rp = 0;
+#pragma HLS array_partition variable=m complete
+#pragma HLS array_partition variable=pack complete
+#pragma HLS array_partition variable=ref dim=2 complete
+#pragma HLS reset variable=pack
+#pragma HLS reset variable=np
+#pragma HLS reset variable=dn
+#pragma HLS reset variable=i
+#pragma HLS reset variable=g
+#pragma HLS reset variable=rp
+
+	// Send a finished group
+	if(full[rsel] && !stream_full(dst)) {
+		hls::vector<T, PE>  y;
+		if(ro == 0) {
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				y[pe] = mask[rsel][pe];
+			}
+		}
+		else {
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				y[pe] = data[rsel][ro-1][pe];
+			}
+		}
+		dst.write(y);
+
+		if(ro < cnt[rsel])  ro++;
+		else {
+			ro = 0;
+			full[rsel] = false;
+			rsel = !rsel;
+		}
+	}
+
+	// Pack an input beat
+	if(!full[wsel] && !src.empty()) {
+		auto const  x = src.read();
+
+		// Values behind the pending ones, nonzero lanes only
+		T  buf[2*PE];
+#pragma HLS array_partition variable=buf complete
+		for(unsigned  j = 0; j < PE; j++) {
+#pragma HLS unroll
+			buf[j] = pack[j];
+			buf[PE+j] = 0;
+		}
+		unsigned  n = np;
+		for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+			T  v = x[pe];
+			if(DELTA) {
+				if(i >= P)  v = x[pe] - ref[rp][pe];
+				ref[rp][pe] = x[pe];
+			}
+			bool const  nz = v != 0;
+			if(g == 0)  m[pe] = 0;
+			m[pe][g] = nz;
+			if(nz)  buf[n++] = v;
+		}
+
+		if(n >= PE) {
+			for(unsigned  j = 0; j < PE; j++) {
+#pragma HLS unroll
+				data[wsel][dn][j] = buf[j];
+				pack[j] = buf[PE+j];
+			}
+			dn++;
+			np = n - PE;
+		}
+		else {
+			for(unsigned  j = 0; j < PE; j++) {
+#pragma HLS unroll
+				pack[j] = buf[j];
+			}
+			np = n;
+		}
+
+		// Close the group at its end or at the end of the frame
+		if((g == G-1) || (i == N-1)) {
+			if(np > 0) {
+				for(unsigned  j = 0; j < PE; j++) {
+#pragma HLS unroll
+					data[wsel][dn][j] = pack[j];
+					pack[j] = 0;
+				}
+				dn++;
+				np = 0;
+			}
+			for(unsigned  pe = 0; pe < PE; pe++) {
+#pragma HLS unroll
+				mask[wsel][pe] = m[pe];
+			}
+			cnt[wsel] = dn;
+			full[wsel] = true;
+			wsel = !wsel;
+			dn = 0;
+			g = 0;
+		}
+		else  g++;
+
+		i  = i  < N-1? i+1  : 0;
+		rp = rp < P-1? rp+1 : 0;
+	}
+
+} // output_encoder()
+
+#ifndef __SYNTHESIS__
+//- Host-Side Decoder --------------------------------------------------------
+// Inverse of output_encoder(). DECONV_ENCODE_NONE passes beats through, so
+// that consumers can decode unconditionally.
+template<
+	unsigned  N,	// beats per frame
+	unsigned  P,	// beats per output pixel
+	unsigned  G,	// beats per group
+	unsigned  MODE,	// DECONV_ENCODE_*
+	size_t    PE,
+	typename  T
+>
+class output_decoder {
+	std::vector<hls::vector<T, PE>>  ref = std::vector<hls::vector<T, PE>>(P);
+	hls::vector<T, PE>  mask;
+	std::vector<T>  vals;
+	unsigned  need = 0;	// nonzero values of the current group
+	unsigned  len = 0;	// beats of the current group, 0 awaiting its mask
+	unsigned  i = 0;	// beat within the frame
+
+public:
+	// Consumes one encoded beat and appends the decoded beats it completes
+	void push(hls::vector<T, PE> const &x, std::vector<hls::vector<T, PE>> &out) {
+		if(MODE == DECONV_ENCODE_NONE) {
+			out.push_back(x);
+			return;
+		}
+
+		if(len == 0) {
+			mask = x;
+			len = G < N-i? G : N-i;
+			need = 0;
+			for(unsigned  g = 0; g < len; g++) {
+				for(unsigned  pe = 0; pe < PE; pe++)  need += mask[pe][g];
+			}
+		}
+		else {
+			for(unsigned  pe = 0; pe < PE; pe++) {
+				if(vals.size() < need)  vals.push_back(x[pe]);
+			}
+		}
+		if(vals.size() < need)  return;
+
+		unsigned  k = 0;
+		for(unsigned  g = 0; g < len; g++) {
+			hls::vector<T, PE>  y;
+			for(unsigned  pe = 0; pe < PE; pe++) {
+				T  v = mask[pe][g]? vals[k++] : T(0);
+				if(MODE == DECONV_ENCODE_DELTA) {
+					if(i >= P)  v = v + ref[i%P][pe];
+					ref[i%P][pe] = v;
+				}
+				y[pe] = v;
+			}
+			out.push_back(y);
+			i = i < N-1? i+1 : 0;
+		}
+		vals.clear();
+		len = 0;
+	}
+};
+#endif
+
+#endif
@@ -0,0 +1,272 @@
+/****************************************************************************
+ * Resize-convolution: upsampling followed by a stride-1 convolution as an
+ * alternative to the transposed convolution of deconv.hpp.
+ *
+ * The activation path reuses the building blocks of deconv():
+ *
+ *   resize_nearest | resize_bilinear(W) -> resize_bilinear(H)
+ *     -> deconv_swg<K, 1> (virtual conv padding) -> deconv_mvu
+ *
+ * A stride-1 window generator emits every window exactly once with taps in
+ * natural order, so the weights are simply replayed cyclically by
+ * conv_weights() from a kernel laid out as [CO/PE][K][K][CI/SIMD][PE][SIMD],
+ * i.e. the unflipped Conv2d kernel.
+ *
+ * Bilinear interpolation follows PyTorch's align_corners=False for an integer
+ * scale factor U. Its interpolation weights are multiples of 1/(2U) per
+ * dimension, so the upsampled activations are produced exactly as integers
+ * scaled by (2U)^2 and widened accordingly. The convolution output carries
+ * the same scale.
+ ***************************************************************************/
+#ifndef RESIZE_CONV_HPP
+#define RESIZE_CONV_HPP
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include <hls_vector.h>
+
+#include "deconv.hpp"
+#include "utils.hpp"
+
+//- Resize Modes -------------------------------------------------------------
+constexpr unsigned  RESIZE_NEAREST  = 1;
+constexpr unsigned  RESIZE_BILINEAR = 2;
+
+//- Activation Type Widening -------------------------------------------------
+template<typename T, unsigned B> struct widen { using  type = T; };
+template<int N, unsigned B> struct widen<ap_uint<N>, B> { using  type = ap_uint<N+B>; };
+template<int N, unsigned B> struct widen<ap_int<N>,  B> { using  type = ap_int<N+B>; };
+
+//===========================================================================
+// Upsampling Stages
+
+template<
+	unsigned  U,	// upsampling factor
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  SF,	// SIMD fold (CI/SIMD)
+	typename  T		// e.g. hls::vector<TI, SIMD>
+>
+void resize_nearest(
+	hls::stream<T> &src,
+	hls::stream<T> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	// The first replica of a row is taken from `src` and recorded for the
+	// remaining U-1 replicas.
+	static T  row[W*SF];
+
+	static unsigned  h  = 0;
+	static unsigned  sh = 0;
+	static unsigned  w  = 0;
+	static unsigned  sw = 0;
+	static unsigned  d  = 0;
+#pragma HLS reset variable=h
+#pragma HLS reset variable=sh
+#pragma HLS reset variable=w
+#pragma HLS reset variable=sw
+#pragma HLS reset variable=d
+
+	if(stream_full(dst))  return;
+
+	T  y;
+	if((sh == 0) && (sw == 0)) {
+		if(!src.read_nb(y))  return;
+		row[w*SF + d] = y;
+	}
+	else  y = row[w*SF + d];
+	dst.write(y);
+
+	if(d != SF-1)  d++;
+	else {
+		d = 0;
+		if(sw != U-1)  sw++;
+		else {
+			sw = 0;
+			if(w != W-1)  w++;
+			else {
+				w = 0;
+				if(sh != U-1)  sh++;
+				else {
+					sh = 0;
+					if(h != H-1)  h++;
+					else  h = 0;
+				}
+			}
+		}
+	}
+
+} // resize_nearest()
+
+template<
+	unsigned  U,	// upsampling factor
+	unsigned  N,	// positions along the interpolated dimension
+	unsigned  L,	// beats per position
+	typename  TI,
+	typename  TU,	// TI widened by clog2(2*U) bits
+	size_t    SIMD
+>
+void resize_bilinear(
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TU, SIMD>> &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+
+#pragma HLS pipeline II=1 style=flp
+	static_assert(U >= 2, "Bilinear upsampling requires a factor of at least 2.");
+
+	// One-dimensional linear interpolation of a sequence of N positions of L
+	// beats each: pixels within a row (L = SF) or complete rows (L = row beats).
+	// Step s interpolates between x[s-1] and x[s] (clamped at both ends) and
+	// emits the outputs at phases j in [U/2, U+U/2), which weight x[s] by
+	// (2j+1-U)/(2U). Step 0 and step N only emit the upper and lower half.
+	static hls::vector<TI, SIMD>  buf[2][L];	// x[s] in buf[p], x[s-1] in buf[!p]
+#pragma HLS array_partition variable=buf dim=1 complete
+	static bool  p = false;
+	static unsigned  s = 0;
+	static unsigned  j = U;
+	static unsigned  l = 0;
+#pragma HLS reset variable=p
+#pragma HLS reset variable=s
+#pragma HLS reset variable=j
+#pragma HLS reset variable=l
+
+	if(stream_full(dst))  return;
+
+	hls::vector<TI, SIMD>  cur;
+	if((s < N) && (j == (s == 0? U : U/2))) {
+		if(!src.read_nb(cur))  return;
+		buf[p][l] = cur;
+	}
+	else  cur = buf[p][l];
+	hls::vector<TI, SIMD>  prev = buf[!p][l];
+	if(s == 0)  prev = cur;
+	if(s == N)  cur = prev;
+
+	unsigned const  wc = 2*j + 1 - U;
+	unsigned const  wp = 2*U - wc;
+	hls::vector<TU, SIMD>  y;
+	for(unsigned  i = 0; i < SIMD; i++) {
+#pragma HLS unroll
+		y[i] = wp*prev[i] + wc*cur[i];
+	}
+	dst.write(y);
+
+	if(l != L-1)  l++;
+	else {
+		l = 0;
+		if(j != (s == N? U-1 : U+U/2-1))  j++;
+		else {
+			p = !p;
+			if(s != N) {
+				s++;
+				j = U/2;
+			}
+			else {
+				s = 0;
+				j = U;
+			}
+		}
+	}
+
+} // resize_bilinear()
+
+template<unsigned  MODE, unsigned  U, unsigned  H, unsigned  W, unsigned  SF>
+struct upsample {};
+
+template<unsigned  U, unsigned  H, unsigned  W, unsigned  SF>
+struct upsample<RESIZE_NEAREST, U, H, W, SF> {
+	template<typename  TI>
+	using  out_t = TI;
+
+	template<typename  TI, size_t  SIMD>
+	static void run(
+		hls::stream<hls::vector<TI, SIMD>> &src,
+		hls::stream<hls::vector<TI, SIMD>> &dst
+	) {
+#pragma HLS inline
+		DECONV_STAGE(resize, resize_nearest<U, H, W, SF>(src, dst));
+	}
+};
+
+template<unsigned  U, unsigned  H, unsigned  W, unsigned  SF>
+struct upsample<RESIZE_BILINEAR, U, H, W, SF> {
+	template<typename  TI>
+	using  out_t = typename widen<TI, 2*clog2(2*U)>::type;
+
+	template<typename  TI, size_t  SIMD>
+	static void run(
+		hls::stream<hls::vector<TI, SIMD>> &src,
+		hls::stream<hls::vector<out_t<TI>, SIMD>> &dst
+	) {
+#pragma HLS inline
+		// Separable: along each row (pixels of SF beats), then along the
+		// columns (upsampled rows of U*W*SF beats)
+		using  TH = typename widen<TI, clog2(2*U)>::type;
+		static hls::stream<hls::vector<TH, SIMD>>  rows("rows");
+		DECONV_STREAM_DEPTH(rows, 2);
+		DECONV_STAGE(resize, resize_bilinear<U, W, SF, TI, TH>(src, rows));
+		DECONV_STAGE(resize, resize_bilinear<U, H, U*W*SF, TH, out_t<TI>>(rows, dst));
+	}
+};
+
+//===========================================================================
+// Resize-Convolution
+
+template<
+	unsigned  MODE,	// RESIZE_NEAREST or RESIZE_BILINEAR
+	unsigned  U,	// upsampling factor
+	unsigned  K,	// kernel Size (stride 1)
+	unsigned  PT,	// zero padding top of the upsampled IFM
+	unsigned  PB,	// zero padding bottom
+	unsigned  PL,	// zero padding left
+	unsigned  PR,	// zero padding right
+	unsigned  H,	// IFM height
+	unsigned  W,	// IFM Width
+	unsigned  CO,	// output channels
+	unsigned  CI,	// input channels
+	size_t    PE,
+	size_t    SIMD,
+	unsigned  B = 1,	// batch of images interleaved beat by beat
+	typename  TW,
+	typename  TI,
+	typename  TO
+>
+void resize_conv(
+	TW const (&kernel)[(CO/PE)*K*K*(CI/SIMD)][PE][SIMD],
+	hls::stream<hls::vector<TI, SIMD>> &src,
+	hls::stream<hls::vector<TO, PE>>   &dst
+) {
+#pragma HLS interface ap_ctrl_none port=return
+#pragma HLS dataflow disable_start_propagation
+
+	// Parameter Validation & Fold Derivation
+	static_assert(CO%PE   == 0, "PE parallelism must divide output channel count.");
+	static_assert(CI%SIMD == 0, "SIMD parallelism must divide input channel count.");
+	static_assert(U*H+PT+PB >= K, "Kernel must fit the padded upsampled IFM height.");
+	static_assert(U*W+PL+PR >= K, "Kernel must fit the padded upsampled IFM width.");
+	constexpr unsigned  CF = CO/PE;
+	constexpr unsigned  SF = CI/SIMD;
+	using  up = upsample<MODE, U, H, W, SF*B>;
+	using  TA = typename up::template out_t<TI>;
+
+	// Continuous Weight Feed
+	static hls::stream<hls::vector<hls::vector<TW, SIMD>, PE>>  wgt("wgt");
+	DECONV_STREAM_DEPTH(wgt, 2);
+	DECONV_STAGE(weights, conv_weights(kernel, wgt));
+
+	// Activation Processing Pipeline: resize -> swg (incl. virtual padding) -> mvu
+	static hls::stream<hls::vector<TA, SIMD>>  ups("ups");
+	static hls::stream<hls::vector<TA, SIMD>>  swg("swg");
+	DECONV_STREAM_DEPTH(ups, 2);
+	DECONV_STREAM_DEPTH(swg, 2);
+
+	up::run(src, ups);
+	DECONV_STAGE(swg, deconv_swg<K, 1, U*H, U*W, CF, SF*B, PT, PB, PL, PR>(ups, swg));
+	DECONV_STAGE(mvu, deconv_mvu_sel<K*K*SF, B>(wgt, swg, dst));
+
+} // resize_conv()
+
+#endif
@@ -49,10 +49,14 @@
 #define UTILS_HPP
 
 #include <ap_int.h>
+#include <hls_stream.h>
 
 #include <iostream>
 #include <fstream>
 #include <cstddef>
+#if !defined(__SYNTHESIS__) && defined(DECONV_CSIM_BOUNDED)
+#include <unordered_map>
+#endif
 
 //- Static Evaluation of ceil(log2(x)) ---------------------------------------
 constexpr unsigned clog2(size_t  x) {
@@ -66,6 +70,129 @@ struct first_param<R (*)(A, Args...)> { typedef A  type; };
 template<typename C, typename R, typename A, typename... Args>
 struct first_param<R (C::*)(A, Args...)> { typedef A  type; };
 
+//- Depth-Bounded Streams in Host Simulation ---------------------------------
+// C simulation models every hls::stream as an unbounded queue so that a
+// producer running ahead of its consumer grows memory instead of stalling.
+// With DECONV_CSIM_BOUNDED defined, stream_depth() records the depth a stream
+// is declared with and stream_full() reports backpressure once it is reached.
+// Producers guard their writes with stream_full(), which is constantly false
+// in synthesis (and unbounded csim) so that the generated hardware is unchanged.
+// Internal streams state their depth once, by DECONV_STREAM_DEPTH(var, n),
+// which emits both the stream pragma and the stream_depth() record.
+#ifndef DECONV_CSIM_PORT_DEPTH
+#define DECONV_CSIM_PORT_DEPTH 2	// depth assumed for the top-level ports
+#endif
+#if !defined(__SYNTHESIS__) && defined(DECONV_CSIM_BOUNDED)
+inline std::unordered_map<void const*, size_t>& stream_depths() {
+  static std::unordered_map<void const*, size_t>  depths;
+  return  depths;
+}
+template<typename T>
+void stream_depth(hls::stream<T> const &s, size_t  depth) {
+  stream_depths()[&s] = depth;
+}
+template<typename T, size_t N>
+void stream_depth(hls::stream<T> const (&s)[N], size_t  depth) {
+  for(size_t  i = 0; i < N; i++)  stream_depth(s[i], depth);
+}
+template<typename T>
+bool stream_full(hls::stream<T> &s) {
+  auto const  it = stream_depths().find(&s);
+  return  (it != stream_depths().end()) && (s.size() >= it->second);
+}
+#else
+template<typename T>
+void stream_depth(hls::stream<T> const&, size_t) {}
+template<typename T, size_t N>
+void stream_depth(hls::stream<T> const (&)[N], size_t) {}
+template<typename T>
+bool stream_full(hls::stream<T>&) { return  false; }
+#endif
+#define DECONV_PRAGMA(x)  _Pragma(#x)
+#define DECONV_STREAM_DEPTH(var, n)  \
+  DECONV_PRAGMA(HLS stream depth=n variable=var)  \
+  stream_depth(var, n)
+
+//- Stage Instrumentation Hook -----------------------------------------------
+// Every dataflow stage of deconv() is invoked through DECONV_STAGE(name, call).
+// It expands to the plain call unless a host harness (src/deconv_bench.cpp)
+// defines it beforehand to bracket the stages with its own probes.
+#ifndef DECONV_STAGE
+#define DECONV_STAGE(name, ...)  __VA_ARGS__
+#endif
+
+//- Batch Interleaving -------------------------------------------------------
+// With DECONV_BATCH = B > 1, deconv_top() processes B images at once. Their
+// streams are interleaved beat by beat with the image index innermost, on
+// the input (pixel, SIMD fold, image) as on the output (pixel, PE fold,
+// image). deconv_swg() keeps the B images in one line buffer and deconv_mvu()
+// applies every weight beat to the B windows at the same position, so the
+// weight stream is read once per batch rather than once per image.
+#ifndef DECONV_BATCH
+#define DECONV_BATCH 1
+#endif
+
+//- Output-Tile Blocking -----------------------------------------------------
+// DECONV_TILE_X x DECONV_TILE_Y > 1 replaces deconv_asym() in deconv_top() by
+// deconv_tiled(), which applies every weight beat to a tile of window
+// positions rather than to a single one. The weight stream shrinks by the
+// tile size; the MVU keeps one accumulator per window of the tile.
+#ifndef DECONV_TILE_X
+#define DECONV_TILE_X 1
+#endif
+#ifndef DECONV_TILE_Y
+#define DECONV_TILE_Y 1
+#endif
+
+//- MVU Microarchitecture ---------------------------------------------------
+// DECONV_MVU selects the matrix-vector unit instantiated by every engine:
+//   DECONV_MVU_BROADCAST  deconv_mvu(), activations broadcast to all PEs
+//   DECONV_MVU_SYSTOLIC   deconv_mvu_systolic(), activations shifted through
+//                         a PE chain; no broadcast net, PE cycles more latency
+//   DECONV_MVU_CASCADE    deconv_mvu_cascade(), SIMD reduction through a
+//                         DSP48E2 PCIN/PCOUT chain; SIMD cycles more latency
+//   DECONV_MVU_FUSED      deconv_mvu_fused(), broadcast MVU addressing the
+//                         kernel ROM itself instead of consuming the weight
+//                         stream of deconv_weights(); deconv_asym() and
+//                         deconv_tiled() only, others use deconv_mvu()
+#define DECONV_MVU_BROADCAST 0
+#define DECONV_MVU_SYSTOLIC  1
+#define DECONV_MVU_CASCADE   2
+#define DECONV_MVU_FUSED     3
+#ifndef DECONV_MVU
+#define DECONV_MVU DECONV_MVU_BROADCAST
+#endif
+
+//- Output Encoding ----------------------------------------------------------
+// DECONV_ENCODE appends output_encoder() (src/output_codec.hpp) to the engine
+// of deconv_top() to reduce the DDR write traffic of the output stream:
+//   DECONV_ENCODE_NONE    raw output beats
+//   DECONV_ENCODE_BITMAP  zero suppression, a mask beat per group of
+//                         DECONV_ENCODE_GROUP beats plus the nonzero values
+//   DECONV_ENCODE_DELTA   difference to the previous pixel, then as BITMAP
+#define DECONV_ENCODE_NONE   0
+#define DECONV_ENCODE_BITMAP 1
+#define DECONV_ENCODE_DELTA  2
+#ifndef DECONV_ENCODE
+#define DECONV_ENCODE DECONV_ENCODE_NONE
+#endif
+#ifndef DECONV_ENCODE_GROUP
+#define DECONV_ENCODE_GROUP 16	// at most the bit width of TO
+#endif
+
+//- Memory-Mapped Frame I/O --------------------------------------------------
+// deconv_maxi_read() and deconv_maxi_write() (src/deconv_maxi_top.cpp) move
+// the frames of deconv_top() between DDR and its stream ports. Their m_axi
+// ports issue bursts of up to DECONV_MAXI_BURST beats with up to
+// DECONV_MAXI_OUTSTANDING transactions in flight, which hides the DDR
+// latency for streaming frames.
+#ifndef DECONV_MAXI_BURST
+#define DECONV_MAXI_BURST 64
+#endif
+#ifndef DECONV_MAXI_OUTSTANDING
+#define DECONV_MAXI_OUTSTANDING 8
+#endif
+
 //- Resource Representatives -------------------------------------------------
 class ap_resource_dflt {};
 class ap_resource_lut {};